@@ -32,7 +32,7 @@ NS_ROOT
 // -----------------------------------------------------------------------------
 
 REGISTER_ATTRIBUTE(iresearch::offset);
-DEFINE_ATTRIBUTE_TYPE(offset);
+DEFINE_ATTRIBUTE_TYPE_SLOT(offset, OFFSET);
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                         increment
@@ -57,7 +57,7 @@ DEFINE_ATTRIBUTE_TYPE(term_attribute);
 // -----------------------------------------------------------------------------
 
 REGISTER_ATTRIBUTE(iresearch::payload);
-DEFINE_ATTRIBUTE_TYPE(payload);
+DEFINE_ATTRIBUTE_TYPE_SLOT(payload, PAYLOAD);
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                  payload_iterator
@@ -71,7 +71,7 @@ DEFINE_ATTRIBUTE_TYPE(payload_iterator);
 // -----------------------------------------------------------------------------
 
 REGISTER_ATTRIBUTE(iresearch::document);
-DEFINE_ATTRIBUTE_TYPE(document);
+DEFINE_ATTRIBUTE_TYPE_SLOT(document, DOCUMENT);
 
 document::document() NOEXCEPT:
   basic_attribute<doc_id_t>(type_limits<type_t::doc_id_t>::invalid()) {
@@ -82,7 +82,14 @@ document::document() NOEXCEPT:
 // -----------------------------------------------------------------------------
 
 REGISTER_ATTRIBUTE(iresearch::frequency);
-DEFINE_ATTRIBUTE_TYPE(frequency);
+DEFINE_ATTRIBUTE_TYPE_SLOT(frequency, FREQUENCY);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      block_bounds
+// -----------------------------------------------------------------------------
+
+REGISTER_ATTRIBUTE(iresearch::block_bounds);
+DEFINE_ATTRIBUTE_TYPE(block_bounds);
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                granularity_prefix
@@ -142,7 +149,7 @@ float_t norm::read() const {
 // -----------------------------------------------------------------------------
 
 REGISTER_ATTRIBUTE(iresearch::position);
-DEFINE_ATTRIBUTE_TYPE(position);
+DEFINE_ATTRIBUTE_TYPE_SLOT(position, POSITION);
 
 position::position(size_t reserve_attrs): attrs_(reserve_attrs) {
 }
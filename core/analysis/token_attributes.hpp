@@ -125,6 +125,42 @@ struct IRESEARCH_API frequency : basic_attribute<uint32_t> {
   frequency() = default;
 }; // frequency
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class block_bounds
+/// @brief bounds of a postings block as known from the skip data, allows to
+///        look ahead of the current document without decoding postings
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API block_bounds : public attribute {
+ public:
+  DECLARE_REFERENCE(block_bounds);
+  DECLARE_TYPE_ID(attribute::type_id);
+
+  virtual ~block_bounds() = default;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief moves bounds to the block which may contain 'target', neither
+  ///        decodes the block nor changes the current document of an iterator
+  /// @returns the least document >= 'target' that may be present in postings
+  //////////////////////////////////////////////////////////////////////////////
+  virtual doc_id_t shallow_seek(doc_id_t target) = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns first document of the block bounds are positioned at
+  //////////////////////////////////////////////////////////////////////////////
+  doc_id_t min() const NOEXCEPT { return min_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns last document of the block bounds are positioned at
+  //////////////////////////////////////////////////////////////////////////////
+  doc_id_t max() const NOEXCEPT { return max_; }
+
+ protected:
+  block_bounds() = default;
+
+  doc_id_t min_{ type_limits<type_t::doc_id_t>::invalid() };
+  doc_id_t max_{ type_limits<type_t::doc_id_t>::eof() };
+}; // block_bounds
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class granularity_prefix
 /// @brief indexed tokens are prefixed with one byte indicating granularity
@@ -73,6 +73,26 @@ field_writer::~field_writer() {}
 postings_reader::~postings_reader() {}
 basic_term_reader::~basic_term_reader() {}
 term_reader::~term_reader() {}
+
+bool term_reader::overlaps(
+    const bytes_ref& min, bool min_inclusive,
+    const bytes_ref& max, bool max_inclusive) const {
+  const auto& field_min = (this->min)();
+  const auto& field_max = (this->max)();
+
+  // readers not tracking min/max terms return null
+  if (!min.null() && !field_max.null()
+      && (field_max < min || (!min_inclusive && field_max == min))) {
+    return false; // all terms are less than the range
+  }
+
+  if (!max.null() && !field_min.null()
+      && (max < field_min || (!max_inclusive && max == field_min))) {
+    return false; // all terms are greater than the range
+  }
+
+  return true;
+}
 field_reader::~field_reader() {}
 
 document_mask_writer::~document_mask_writer() {}
@@ -209,6 +209,18 @@ struct IRESEARCH_API term_reader: public util::const_attribute_view_provider {
 
   // most significant term
   virtual const bytes_ref& (max)() const = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief checks the specified range against min/max terms of the field,
+  ///        i.e. without accessing the term dictionary
+  /// @param min lower bound of the range, null == unbounded
+  /// @param max upper bound of the range, null == unbounded
+  /// @return false if the field has no terms within the range for sure
+  //////////////////////////////////////////////////////////////////////////////
+  bool overlaps(
+    const bytes_ref& min, bool min_inclusive,
+    const bytes_ref& max, bool max_inclusive
+  ) const;
 };
 
 /* -------------------------------------------------------------------
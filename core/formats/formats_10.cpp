@@ -73,6 +73,7 @@ NS_LOCAL
 struct format_traits {
   static const uint32_t BLOCK_SIZE = 128;
   static const irs::string_ref NAME;
+  static const irs::string_ref EF_NAME;
 
   FORCE_INLINE static void write_block(
       irs::index_output& out,
@@ -98,6 +99,7 @@ struct format_traits {
 }; // format_traits
 
 const irs::string_ref format_traits::NAME = "1_0";
+const irs::string_ref format_traits::EF_NAME = "1_0-ef";
 
 NS_END
 
@@ -114,6 +116,7 @@ NS_LOCAL
 struct format_traits {
   static const uint32_t BLOCK_SIZE = 128;
   static const irs::string_ref NAME;
+  static const irs::string_ref EF_NAME;
 
   FORCE_INLINE static void write_block(
       irs::index_output& out,
@@ -139,6 +142,7 @@ struct format_traits {
 }; // format_traits
 
 const irs::string_ref format_traits::NAME = "1_0";
+const irs::string_ref format_traits::EF_NAME = "1_0-ef";
 
 NS_END
 
@@ -244,7 +248,7 @@ inline void prepare_output(
   format_utils::write_header(*out, format, version);
 }
 
-inline void prepare_input(
+inline int32_t prepare_input(
     std::string& str,
     index_input::ptr& in,
     IOAdvice advice,
@@ -264,9 +268,200 @@ inline void prepare_input(
     ));
   }
 
-  format_utils::check_header(*in, format, min_ver, max_ver);
+  return format_utils::check_header(*in, format, min_ver, max_ver);
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                          elias-fano block coding
+// ----------------------------------------------------------------------------
+//
+// Partitioned Elias-Fano encoding, every full document block is a separate
+// partition holding non-decreasing offsets relative to the last document of
+// the previous block. Each partition is stored either as an Elias-Fano
+// sequence or as a plain bitmap over its universe, whichever is smaller:
+//   <PartitionHeader>
+//     </MaxValue>, </IsBitmap>
+//   </PartitionHeader>
+//   </PackedWords>
+//
+// Elias-Fano sequence of 'size' values within [0;max] consists of:
+//   'size' lower halves of 'low' bits each
+//   upper halves in unary, a value 'v' at index 'i' sets bit '(v >> low) + i'
+//
+// ----------------------------------------------------------------------------
+
+// encoding of the full document blocks in a postings list
+enum class doc_codec {
+  BITPACK, // delta encoded, bit packed blocks
+  ELIAS_FANO // partitioned Elias-Fano/bitmap blocks
+}; // doc_codec
+
+NS_BEGIN(elias_fano)
+
+const uint32_t WORD_BITS = bits_required<uint32_t>();
+
+// returns number of lower bits to use for 'size' values within [0;max]
+inline uint32_t low_bits(uint64_t max, uint32_t size) NOEXCEPT {
+  const uint64_t universe = max + 1;
+
+  return universe > size
+    ? uint32_t(math::log2_floor_64(universe / size))
+    : 0;
+}
+
+// returns number of bits required to store a partition
+inline uint64_t partition_bits(uint64_t max, uint32_t size, bool bitmap) NOEXCEPT {
+  if (bitmap) {
+    return max + 1;
+  }
+
+  const auto low = low_bits(max, size);
+
+  return uint64_t(size)*low + size + (max >> low) + 1;
+}
+
+inline size_t words_required(uint64_t bits) NOEXCEPT {
+  return size_t((bits + WORD_BITS - 1) / WORD_BITS);
+}
+
+inline void set(uint32_t* words, uint64_t bit) NOEXCEPT {
+  words[bit / WORD_BITS] |= uint32_t(1) << (bit % WORD_BITS);
+}
+
+// writes 'bits' lower bits of 'value' at the specified bit position
+inline void write_bits(uint32_t* words, uint64_t pos, uint32_t value, uint32_t bits) NOEXCEPT {
+  assert(bits <= WORD_BITS);
+
+  if (!bits) {
+    return;
+  }
+
+  const auto idx = pos / WORD_BITS;
+  const auto shift = pos % WORD_BITS;
+  const uint64_t mask = (UINT64_C(1) << bits) - 1;
+  const uint64_t v = (uint64_t(value) & mask) << shift;
+
+  words[idx] |= uint32_t(v);
+
+  if (shift + bits > WORD_BITS) {
+    words[idx + 1] |= uint32_t(v >> WORD_BITS);
+  }
+}
+
+// reads 'bits' bits at the specified bit position
+inline uint32_t read_bits(const uint32_t* words, uint64_t pos, uint32_t bits) NOEXCEPT {
+  assert(bits <= WORD_BITS);
+
+  if (!bits) {
+    return 0;
+  }
+
+  const auto idx = pos / WORD_BITS;
+  const auto shift = pos % WORD_BITS;
+  const uint64_t mask = (UINT64_C(1) << bits) - 1;
+  uint64_t v = words[idx];
+
+  if (shift + bits > WORD_BITS) {
+    v |= uint64_t(words[idx + 1]) << WORD_BITS;
+  }
+
+  return uint32_t((v >> shift) & mask);
+}
+
+// writes partition of the specified size to stream,
+// 'encoded' must be able to hold at least 'size' words
+void write_block(
+    data_output& out,
+    const uint32_t* RESTRICT decoded,
+    uint32_t size,
+    uint32_t* RESTRICT encoded) {
+  assert(size);
+  assert(std::is_sorted(decoded, decoded + size));
+
+  const uint64_t max = decoded[size - 1];
+  const bool bitmap = partition_bits(max, size, true) <= partition_bits(max, size, false);
+  const auto words = words_required(partition_bits(max, size, bitmap));
+  assert(words <= size);
+
+  std::memset(encoded, 0, sizeof(uint32_t)*words);
+
+  if (bitmap) {
+    for (auto begin = decoded, end = decoded + size; begin != end; ++begin) {
+      set(encoded, *begin);
+    }
+  } else {
+    const auto low = low_bits(max, size);
+    const uint64_t upper = uint64_t(size)*low;
+
+    for (uint32_t i = 0; i < size; ++i) {
+      const uint64_t value = decoded[i];
+
+      write_bits(encoded, i*uint64_t(low), uint32_t(value), low);
+      set(encoded, upper + (value >> low) + i);
+    }
+  }
+
+  out.write_vlong(shift_pack_64(max, bitmap));
+  out.write_bytes(
+    reinterpret_cast<const byte_type*>(encoded),
+    sizeof(uint32_t)*words
+  );
+}
+
+// reads partition of the specified size from the stream that was
+// previously encoded with the corresponding 'write_block' function
+void read_block(
+    data_input& in,
+    uint32_t size,
+    uint32_t* RESTRICT encoded,
+    uint32_t* RESTRICT decoded) {
+  assert(size);
+
+  uint64_t max;
+  const bool bitmap = shift_unpack_64(in.read_vlong(), max);
+  const auto words = words_required(partition_bits(max, size, bitmap));
+  const auto required = sizeof(uint32_t)*words;
+
+  if (words > size) {
+    throw index_error(string_utils::to_string(
+      "while reading elias-fano block, error: invalid block size '" IR_SIZE_T_SPECIFIER "'",
+      words
+    ));
+  }
+
+#ifdef IRESEARCH_DEBUG
+  const auto read = in.read_bytes(reinterpret_cast<byte_type*>(encoded), required);
+  assert(read == required);
+  UNUSED(read);
+#else
+  in.read_bytes(reinterpret_cast<byte_type*>(encoded), required);
+#endif // IRESEARCH_DEBUG
+
+  const uint32_t low = bitmap ? 0 : low_bits(max, size);
+  const uint64_t upper = bitmap ? 0 : uint64_t(size)*low;
+  auto idx = size_t(upper / WORD_BITS);
+  auto word = encoded[idx] & (integer_traits<uint32_t>::const_max << (upper % WORD_BITS));
+
+  for (uint32_t i = 0; i < size; ) {
+    while (!word) {
+      word = encoded[++idx];
+    }
+
+    const uint64_t bit = uint64_t(idx)*WORD_BITS + math::ctz32(word);
+    word &= word - 1; // unset the lowest bit
+
+    if (bitmap) {
+      decoded[i++] = uint32_t(bit);
+    } else {
+      const uint64_t high = bit - upper - i;
+      decoded[i] = uint32_t((high << low) | read_bits(encoded, i*uint64_t(low), low));
+      ++i;
+    }
+  }
+}
+
+NS_END // elias_fano
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                  postings_writer
 // ----------------------------------------------------------------------------
@@ -282,9 +477,11 @@ class postings_writer final: public irs::postings_writer {
  public:
   static const string_ref TERMS_FORMAT_NAME;
   static const int32_t TERMS_FORMAT_MIN = 0;
-  static const int32_t TERMS_FORMAT_MAX = TERMS_FORMAT_MIN;
+  static const int32_t TERMS_FORMAT_BITMAP = 1; // terms of docs-only fields may be stored as bitmaps
+  static const int32_t TERMS_FORMAT_MAX = TERMS_FORMAT_BITMAP;
 
   static const string_ref DOC_FORMAT_NAME;
+  static const string_ref DOC_EF_FORMAT_NAME;
   static const string_ref DOC_EXT;
   static const string_ref POS_FORMAT_NAME;
   static const string_ref POS_EXT;
@@ -292,13 +489,18 @@ class postings_writer final: public irs::postings_writer {
   static const string_ref PAY_EXT;
 
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const int32_t FORMAT_BLOCK_BOUNDS = 1; // skip entries store the first document of a block
+  static const int32_t FORMAT_MAX = FORMAT_BLOCK_BOUNDS;
 
   static const uint32_t MAX_SKIP_LEVELS = 10;
   static const uint32_t BLOCK_SIZE = format_traits::BLOCK_SIZE;
   static const uint32_t SKIP_N = 8;
 
-  explicit postings_writer(bool volatile_attributes);
+  // postings of a docs-only field are stored as a bitmap if the term
+  // is present in at least 1/BITMAP_DENSITY of the segment documents
+  static const uint32_t BITMAP_DENSITY = 4;
+
+  postings_writer(bool volatile_attributes, doc_codec codec);
 
   // ------------------------------------------
   // const_attributes_provider
@@ -345,6 +547,7 @@ class postings_writer final: public irs::postings_writer {
       stream::reset();
       last = type_limits<type_t::doc_id_t>::invalid();
       block_last = 0;
+      block_first = 0;
       size = 0;
     }
 
@@ -353,7 +556,9 @@ class postings_writer final: public irs::postings_writer {
     std::unique_ptr<uint32_t[]> freqs; // document frequencies
     doc_id_t last{ type_limits<type_t::doc_id_t>::invalid() }; // last buffered document id
     doc_id_t block_last{}; // last document id in a block
+    doc_id_t block_first{}; // first document id in a block
     uint32_t size{}; // number of buffered elements
+    doc_codec codec{ doc_codec::BITPACK }; // encoding of full document blocks
   }; // doc_stream
 
   struct pos_stream : stream {
@@ -408,6 +613,8 @@ class postings_writer final: public irs::postings_writer {
   void add_position( uint32_t pos, const offset* offs, const payload* pay );
   void end_doc();
   void end_term(version10::term_meta& state, const uint32_t* tfreq);
+  void write_docs(version10::term_meta& state);
+  void write_bitmap(version10::term_meta& state);
 
   memory::memory_pool<> meta_pool_;
   memory::memory_pool_allocator<version10::term_meta, decltype(meta_pool_)> alloc_{ meta_pool_ };
@@ -419,6 +626,7 @@ class postings_writer final: public irs::postings_writer {
   pos_stream::ptr pos_;            // proximity stream
   pay_stream::ptr pay_;            // payloads and offsets stream
   size_t docs_count{};             // count of processed documents
+  std::vector<doc_id_t> term_docs_; // buffered documents of a term of docs-only field
   version10::documents docs_;      // bit set of all processed documents
   features features_;              // features supported by current field
   bool volatile_attributes_;       // attribute value memory locations may change after next()
@@ -430,6 +638,7 @@ MSVC2015_ONLY(__pragma(warning(disable: 4592))) // symbol will be dynamically in
 const string_ref postings_writer::TERMS_FORMAT_NAME = "iresearch_10_postings_terms";
 
 const string_ref postings_writer::DOC_FORMAT_NAME = "iresearch_10_postings_documents";
+const string_ref postings_writer::DOC_EF_FORMAT_NAME = "iresearch_10_ef_postings_documents";
 const string_ref postings_writer::DOC_EXT = "doc";
 
 const string_ref postings_writer::POS_FORMAT_NAME = "iresearch_10_postings_positions";
@@ -441,7 +650,13 @@ const string_ref postings_writer::PAY_EXT = "pay";
 MSVC2015_ONLY(__pragma(warning(pop)))
 
 void postings_writer::doc_stream::flush(uint32_t* buf, bool freq) {
-  format_traits::write_block(*out, deltas, BLOCK_SIZE, buf);
+  if (doc_codec::ELIAS_FANO == codec) {
+    // partition stores offsets from the last document of the previous block
+    encode::delta::decode(std::begin(deltas), std::end(deltas));
+    elias_fano::write_block(*out, deltas, BLOCK_SIZE, buf);
+  } else {
+    format_traits::write_block(*out, deltas, BLOCK_SIZE, buf);
+  }
 
   if (freq) {
     format_traits::write_block(*out, freqs.get(), BLOCK_SIZE, buf);
@@ -487,10 +702,11 @@ void postings_writer::pay_stream::flush_offsets(uint32_t* buf) {
   format_traits::write_block(*out, offs_len_buf, BLOCK_SIZE, buf);
 }
 
-postings_writer::postings_writer(bool volatile_attributes)
+postings_writer::postings_writer(bool volatile_attributes, doc_codec codec)
   : skip_(BLOCK_SIZE, SKIP_N),
     volatile_attributes_(volatile_attributes) {
   attrs_.emplace(docs_);
+  doc.codec = codec;
 }
 
 void postings_writer::prepare(index_output& out, const iresearch::flush_state& state) {
@@ -503,7 +719,11 @@ void postings_writer::prepare(index_output& out, const iresearch::flush_state& s
   std::string name;
 
   // prepare document stream
-  prepare_output(name, doc.out, state, DOC_EXT, DOC_FORMAT_NAME, FORMAT_MAX);
+  prepare_output(
+    name, doc.out, state, DOC_EXT,
+    doc_codec::ELIAS_FANO == doc.codec ? DOC_EF_FORMAT_NAME : DOC_FORMAT_NAME,
+    FORMAT_MAX
+  );
 
   auto& features = *state.features;
   if (features.check<frequency>() && !doc.freqs) {
@@ -583,6 +803,28 @@ irs::postings_writer::state postings_writer::write(irs::doc_iterator& docs) {
 
   auto meta = memory::allocate_unique<version10::term_meta>(alloc_);
 
+  if (!freq) {
+    // documents only, defer encoding until the density of the term is known
+    term_docs_.clear();
+
+    while (docs.next()) {
+      const auto did = docs.value();
+
+      assert(type_limits<type_t::doc_id_t>::valid(did));
+      term_docs_.push_back(did);
+      docs_.value.set(did - type_limits<type_t::doc_id_t>::min());
+    }
+
+    if (term_docs_.size() > BLOCK_SIZE
+        && term_docs_.size()*BITMAP_DENSITY >= docs_.value.size()) {
+      write_bitmap(*meta);
+    } else {
+      write_docs(*meta);
+    }
+
+    return make_state(*meta.release());
+  }
+
   if (freq) {
     if (pos && !volatile_attributes_) {
       auto& attrs = pos->attributes();
@@ -645,6 +887,65 @@ void postings_writer::release(irs::term_meta *meta) NOEXCEPT {
   #pragma GCC diagnostic pop
 #endif
 
+void postings_writer::write_docs(version10::term_meta& meta) {
+  begin_term();
+
+  for (const auto did : term_docs_) {
+    begin_doc(did, nullptr);
+    ++meta.docs_count;
+    end_doc();
+  }
+
+  end_term(meta, nullptr);
+}
+
+void postings_writer::write_bitmap(version10::term_meta& meta) {
+  typedef decltype(docs_.value)::word_t word_t;
+  static const size_t BITS = bits_required<word_t>();
+
+  assert(!term_docs_.empty());
+  const auto min = (type_limits<type_t::doc_id_t>::min)();
+  const size_t first = (term_docs_.front() - min) / BITS;
+  const size_t last = (term_docs_.back() - min) / BITS;
+
+  data_output& out = *doc.out;
+  doc.start = doc.out->file_pointer();
+
+  // header: index of the first stored word and number of stored words
+  out.write_vlong(first);
+  out.write_vlong(last - first + 1);
+
+  size_t i = first;
+  word_t word = 0;
+  doc_id_t prev = min;
+
+  for (const auto did : term_docs_) {
+    if (did < prev) {
+      throw index_error(string_utils::to_string(
+        "while writing bitmap in postings_writer, error: docs out of order '%d' < '%d'",
+        did, prev
+      ));
+    }
+
+    const size_t bit = did - min;
+
+    for (; i < bit / BITS; ++i) {
+      out.write_long(word);
+      word = 0;
+    }
+
+    set_bit(word, bit % BITS);
+    prev = did;
+  }
+
+  out.write_long(word);
+
+  meta.docs_count = static_cast<uint32_t>(term_docs_.size());
+  meta.freq = integer_traits<uint32_t>::const_max;
+  meta.doc_start = doc.start;
+  meta.bitmap = true;
+}
+
 void postings_writer::begin_term() {
   doc.start = doc.out->file_pointer();
   std::fill_n(doc.skip_ptr, MAX_SKIP_LEVELS, doc.start);
@@ -666,6 +967,7 @@ void postings_writer::begin_term() {
 
 void postings_writer::begin_doc(doc_id_t id, const frequency* freq) {
   if (type_limits<type_t::doc_id_t>::valid(doc.block_last) && 0 == doc.size) {
+    doc.block_first = id;
     skip_.skip(docs_count);
   }
 
@@ -865,6 +1167,7 @@ void postings_writer::write_skip(size_t level, index_output& out) {
   const uint64_t doc_ptr = doc.out->file_pointer();
 
   out.write_vint(doc_delta);
+  out.write_vint(doc.block_first - doc.block_last);
   out.write_vlong(doc_ptr - doc.skip_ptr[level]);
 
   doc.skip_doc[level] = doc.block_last;
@@ -904,7 +1207,12 @@ void postings_writer::encode(
   const auto& meta = static_cast<const version10::term_meta&>(state);
 #endif // IRESEARCH_DEBUG
 
-  out.write_vint(meta.docs_count);
+  if (features_.freq()) {
+    out.write_vint(meta.docs_count);
+  } else {
+    out.write_vint(shift_pack_32(meta.docs_count, meta.bitmap));
+  }
+
   if (meta.freq != integer_traits<uint32_t>::const_max) {
     assert(meta.freq >= meta.docs_count);
     out.write_vint(meta.freq - meta.docs_count);
@@ -921,7 +1229,8 @@ void postings_writer::encode(
     }
   }
 
-  if (1U == meta.docs_count || meta.docs_count > postings_writer::BLOCK_SIZE) {
+  if (!meta.bitmap
+      && (1U == meta.docs_count || meta.docs_count > postings_writer::BLOCK_SIZE)) {
     out.write_vlong(meta.e_skip_start);
   }
 
@@ -949,6 +1258,7 @@ struct skip_state {
   uint64_t pay_ptr{}; // pointer to the payloads of the first document in a document block
   size_t pend_pos{}; // positions to skip before new document block
   doc_id_t doc{ type_limits<type_t::doc_id_t>::invalid() }; // last document in a previous block
+  doc_id_t first{ type_limits<type_t::doc_id_t>::invalid() }; // first document in a block
   uint32_t pay_pos{}; // payload size to skip before in new document block
 }; // skip_state
 
@@ -999,7 +1309,8 @@ class doc_iterator : public iresearch::doc_iterator {
 
   doc_iterator() NOEXCEPT
     : skip_levels_(1),
-      skip_(postings_writer::BLOCK_SIZE, postings_writer::SKIP_N) {
+      skip_(postings_writer::BLOCK_SIZE, postings_writer::SKIP_N),
+      bounds_(*this) {
     std::fill(docs_, docs_ + postings_writer::BLOCK_SIZE, type_limits<type_t::doc_id_t>::invalid());
   }
 
@@ -1007,20 +1318,31 @@ class doc_iterator : public iresearch::doc_iterator {
       const features& field,
       const features& enabled,
       const irs::attribute_view& attrs,
+      doc_codec codec,
+      int32_t version,
       const index_input* doc_in,
       const index_input* pos_in,
       const index_input* pay_in) {
     features_ = field; // set field features
     enabled_ = enabled; // set enabled features
+    codec_ = codec; // set encoding of document blocks
+    version_ = version; // set version of document stream
+
+    // drop the state of the previously iterated term since instances are pooled
+    reset();
 
     // add mandatory attributes
     attrs_.emplace(doc_);
-    begin_ = end_ = docs_;
 
     // get state attribute
     assert(attrs.contains<version10::term_meta>());
     term_state_ = *attrs.get<version10::term_meta>();
 
+    if (term_state_.docs_count > postings_writer::BLOCK_SIZE) {
+      // block bounds are known from skip data only
+      attrs_.emplace<block_bounds>(bounds_);
+    }
+
     // init document stream
     if (term_state_.docs_count > 1) {
       if (!doc_in_) {
@@ -1040,14 +1362,48 @@ class doc_iterator : public iresearch::doc_iterator {
     prepare_attributes(enabled, attrs, pos_in, pay_in);
   }
 
+  // drops reopened inputs, i.e. idle pooled iterators don't hold file handles
+  virtual void release_inputs() NOEXCEPT {
+    skip_.release();
+    skip_loaded_ = false;
+    doc_in_.reset();
+  }
+
   virtual doc_id_t seek(doc_id_t target) override {
     if (target <= doc_.value) {
       return doc_.value;
     }
 
     seek_to_block(target);
-    iresearch::seek(*this, target);
-    return value();
+
+    // documents of a decoded block are sorted, there is
+    // no need to visit each of them in order to find a target
+    for (;;) {
+      if (begin_ == end_) {
+        if (!next() || target <= doc_.value) {
+          return doc_.value;
+        }
+
+        continue;
+      }
+
+      const doc_id_t* end = end_;
+      const auto* it = std::lower_bound(begin_, end, target);
+      const auto found = it != end;
+
+      if (!found) {
+        --it; // consume the whole block, the last document is the base for the next one
+      }
+
+      doc_freq_ += std::distance(begin_, it);
+      begin_ = it + 1;
+      doc_.value = *it;
+      freq_.value = *doc_freq_++;
+
+      if (found) {
+        return doc_.value;
+      }
+    }
   }
 
   virtual doc_id_t value() const override {
@@ -1110,7 +1466,26 @@ class doc_iterator : public iresearch::doc_iterator {
   virtual void seek_notify(const skip_context& /*ctx*/) {
   }
 
+  void reset() NOEXCEPT {
+    attrs_.clear();
+    skip_levels_.resize(1);
+    skip_levels_.front() = skip_state();
+    skip_block_ = skip_context();
+    skip_pos_ = 0;
+    skip_loaded_ = false;
+    bounds_.min_ = type_limits<type_t::doc_id_t>::invalid();
+    bounds_.max_ = type_limits<type_t::doc_id_t>::eof();
+    cur_pos_ = 0;
+    begin_ = end_ = docs_;
+    doc_freq_ = nullptr;
+    term_freq_ = 0;
+    doc_.value = type_limits<type_t::doc_id_t>::invalid();
+    freq_.value = 0;
+  }
+
+  void skip_to_block(doc_id_t target);
   void seek_to_block(doc_id_t target);
+  doc_id_t shallow_seek(doc_id_t target);
 
   // returns current position in the document block 'docs_'
   size_t relative_pos() NOEXCEPT {
@@ -1120,6 +1495,9 @@ class doc_iterator : public iresearch::doc_iterator {
 
   doc_id_t read_skip(skip_state& state, index_input& in) {
     state.doc = in.read_vint();
+    state.first = version_ < postings_writer::FORMAT_BLOCK_BOUNDS
+      ? state.doc + 1 // the closest document which may follow the previous block
+      : state.doc + in.read_vint();
     state.doc_ptr += in.read_vlong();
 
     if (features_.position()) {
@@ -1158,15 +1536,27 @@ class doc_iterator : public iresearch::doc_iterator {
 
   void refill() {
     const auto left = term_state_.docs_count - cur_pos_;
+    bool partition = false; // block holds offsets rather than deltas
 
     if (left >= postings_writer::BLOCK_SIZE) {
-      // read doc deltas
-      format_traits::read_block(
-        *doc_in_,
-        postings_writer::BLOCK_SIZE,
-        enc_buf_,
-        docs_
-      );
+      if (doc_codec::ELIAS_FANO == codec_) {
+        // read doc offsets
+        elias_fano::read_block(
+          *doc_in_,
+          postings_writer::BLOCK_SIZE,
+          enc_buf_,
+          docs_
+        );
+        partition = true;
+      } else {
+        // read doc deltas
+        format_traits::read_block(
+          *doc_in_,
+          postings_writer::BLOCK_SIZE,
+          enc_buf_,
+          docs_
+        );
+      }
 
       if (features_.freq()) {
         // read frequency it is required by
@@ -1198,21 +1588,52 @@ class doc_iterator : public iresearch::doc_iterator {
     }
 
     // if this is the initial doc_id then set it to min() for proper delta value
-    // add last doc_id before decoding
-    *docs_ += type_limits<type_t::doc_id_t>::valid(doc_.value)
+    const auto base = type_limits<type_t::doc_id_t>::valid(doc_.value)
       ? doc_.value
       : (type_limits<type_t::doc_id_t>::min)();
 
-    // decode delta encoded documents block
-    encode::delta::decode(std::begin(docs_), end_);
+    if (partition) {
+      // add last doc_id to every offset of the partition
+      for (auto* doc = docs_; doc != end_; ++doc) {
+        *doc += base;
+      }
+    } else {
+      // add last doc_id before decoding
+      *docs_ += base;
+
+      // decode delta encoded documents block
+      encode::delta::decode(std::begin(docs_), end_);
+    }
 
     begin_ = docs_;
     doc_freq_ = docs_ + postings_writer::BLOCK_SIZE;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @class bounds
+  /// @brief exposes bounds of document blocks without decoding them
+  //////////////////////////////////////////////////////////////////////////////
+  class bounds final : public block_bounds {
+   public:
+    explicit bounds(doc_iterator& it) NOEXCEPT : it_(&it) { }
+
+    virtual doc_id_t shallow_seek(doc_id_t target) override {
+      return it_->shallow_seek(target);
+    }
+
+   private:
+    friend class doc_iterator;
+
+    doc_iterator* it_;
+  }; // bounds
+
   std::vector<skip_state> skip_levels_;
   skip_reader skip_;
   skip_context* skip_ctx_; // pointer to used skip context, will be used by skip reader
+  skip_context skip_block_; // start of the block the skip list is positioned at
+  size_t skip_pos_{}; // number of documents preceding 'skip_block_'
+  bool skip_loaded_{}; // skip list of the current term is loaded
+  bounds bounds_;
   irs::attribute_view attrs_;
   uint32_t enc_buf_[postings_writer::BLOCK_SIZE]; // buffer for encoding
   doc_id_t docs_[postings_writer::BLOCK_SIZE]; // doc values
@@ -1228,16 +1649,18 @@ class doc_iterator : public iresearch::doc_iterator {
   version10::term_meta term_state_;
   features features_; // field features
   features enabled_; // enabled iterator features
+  doc_codec codec_{ doc_codec::BITPACK }; // encoding of document blocks
+  int32_t version_{ postings_writer::FORMAT_MIN }; // version of document stream
 }; // doc_iterator
 
-void doc_iterator::seek_to_block(doc_id_t target) {
+void doc_iterator::skip_to_block(doc_id_t target) {
   // check whether it make sense to use skip-list
   if (skip_levels_.front().doc < target && term_state_.docs_count > postings_writer::BLOCK_SIZE) {
     skip_context last; // where block starts
     skip_ctx_ = &last;
 
     // init skip writer in lazy fashion
-    if (!skip_) {
+    if (!skip_loaded_) {
       index_input::ptr skip_in = doc_in_->dup();
       skip_in->seek(term_state_.doc_start + term_state_.e_skip_start);
 
@@ -1277,19 +1700,195 @@ void doc_iterator::seek_to_block(doc_id_t target) {
         top.pos_ptr = term_state_.pos_start;
         top.pay_ptr = term_state_.pay_start;
       }
+
+      skip_loaded_ = true;
     }
 
     const size_t skipped = skip_.seek(target);
-    if (skipped > (cur_pos_ + relative_pos())) {
-      doc_in_->seek(last.doc_ptr);
-      doc_.value = last.doc;
-      cur_pos_ = skipped;
-      begin_ = end_ = docs_; // will trigger refill in "next"
-      seek_notify(last); // notifies derivatives
+    if (skipped > skip_pos_) {
+      // skip list moved forward, remember where the block starts
+      skip_block_ = last;
+      skip_pos_ = skipped;
     }
   }
 }
 
+void doc_iterator::seek_to_block(doc_id_t target) {
+  skip_to_block(target);
+
+  // the block may have been reached by 'shallow_seek' before
+  if (skip_pos_ > (cur_pos_ + relative_pos()) && skip_block_.doc < target) {
+    doc_in_->seek(skip_block_.doc_ptr);
+    doc_.value = skip_block_.doc;
+    cur_pos_ = skip_pos_;
+    begin_ = end_ = docs_; // will trigger refill in "next"
+    seek_notify(skip_block_); // notifies derivatives
+  }
+}
+
+doc_id_t doc_iterator::shallow_seek(doc_id_t target) {
+  if (target <= doc_.value) {
+    bounds_.min_ = bounds_.max_ = doc_.value;
+    return doc_.value;
+  }
+
+  if (begin_ != end_ && target <= *(end_ - 1)) {
+    // target is within the decoded block
+    bounds_.min_ = *docs_;
+    bounds_.max_ = *(end_ - 1);
+    return *std::lower_bound(begin_, static_cast<const doc_id_t*>(end_), target);
+  }
+
+  skip_to_block(target);
+
+  if (skip_pos_ > (cur_pos_ + relative_pos()) && skip_block_.doc < target) {
+    // target is within the block the skip list is positioned at
+    bounds_.min_ = skip_block_.first;
+    bounds_.max_ = skip_levels_.front().doc;
+    return std::max(target, skip_block_.first);
+  }
+
+  bounds_.min_ = type_limits<type_t::doc_id_t>::invalid();
+  bounds_.max_ = type_limits<type_t::doc_id_t>::eof();
+
+  return target;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @class bitmap_doc_iterator
+/// @brief iterates over postings stored as a bitmap of documents, the bitmap
+///        is loaded in chunks, a word containing the target document is
+///        addressed directly so 'seek' doesn't depend on the skipped distance
+///////////////////////////////////////////////////////////////////////////////
+class bitmap_doc_iterator final : public irs::doc_iterator {
+ public:
+  typedef uint64_t word_t;
+
+  DECLARE_UNIQUE_PTR(bitmap_doc_iterator);
+
+  DEFINE_FACTORY_INLINE(bitmap_doc_iterator);
+
+  void prepare(const irs::attribute_view& attrs, const index_input* doc_in) {
+    // add mandatory attributes
+    attrs_.emplace(doc_);
+
+    // get state attribute
+    assert(attrs.contains<version10::term_meta>());
+    const auto& term_state = *attrs.get<version10::term_meta>();
+    assert(term_state.bitmap);
+
+    if (!doc_in_) {
+      doc_in_ = doc_in->reopen();
+
+      if (!doc_in_) {
+        IR_FRMT_FATAL("Failed to reopen document input in: %s", __FUNCTION__);
+
+        throw detailed_io_error("failed to reopen document input");
+      }
+    }
+
+    // drop the state of the previously iterated term since instances are pooled
+    doc_.value = type_limits<type_t::doc_id_t>::invalid();
+    word_ = 0;
+
+    doc_in_->seek(term_state.doc_start);
+    word_begin_ = doc_in_->read_vlong();
+    word_end_ = word_begin_ + doc_in_->read_vlong();
+    data_start_ = doc_in_->file_pointer();
+    next_word_ = word_begin_;
+    buf_begin_ = buf_end_ = word_begin_;
+  }
+
+  // drops reopened input, i.e. idle pooled iterators don't hold file handles
+  void release_inputs() NOEXCEPT {
+    doc_in_.reset();
+  }
+
+  virtual doc_id_t value() const NOEXCEPT override {
+    return doc_.value;
+  }
+
+  virtual const irs::attribute_view& attributes() const NOEXCEPT override {
+    return attrs_;
+  }
+
+  virtual bool next() override {
+    while (!word_) {
+      if (next_word_ >= word_end_) {
+        doc_.value = type_limits<type_t::doc_id_t>::eof();
+        return false;
+      }
+
+      word_ = load(next_word_++);
+    }
+
+    const size_t bit = (next_word_ - 1) * BITS + math::math_traits<word_t>::ctz(word_);
+    word_ &= word_ - 1; // consume the lowest set bit
+    doc_.value = doc_id_t(bit + (type_limits<type_t::doc_id_t>::min)());
+
+    return true;
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    if (target <= doc_.value) {
+      return doc_.value;
+    }
+
+    const size_t bit = target - (type_limits<type_t::doc_id_t>::min)();
+    const size_t i = bit / BITS;
+
+    if (i >= word_end_) {
+      next_word_ = word_end_;
+      word_ = 0;
+      doc_.value = type_limits<type_t::doc_id_t>::eof();
+      return doc_.value;
+    }
+
+    if (i >= word_begin_) {
+      // drop bits preceding the target in the target word
+      word_ = load(i) & (~word_t(0) << (bit % BITS));
+      next_word_ = i + 1;
+    }
+
+    next();
+
+    return doc_.value;
+  }
+
+ private:
+  static const size_t BITS = bits_required<word_t>();
+  static const size_t BUF_SIZE = 64; // number of words loaded at once
+
+  // returns word 'i' of the bitmap, 'i' must be in [word_begin_, word_end_)
+  word_t load(size_t i) {
+    assert(i >= word_begin_ && i < word_end_);
+
+    if (i < buf_begin_ || i >= buf_end_) {
+      buf_begin_ = i;
+      buf_end_ = std::min(i + BUF_SIZE, word_end_);
+      doc_in_->seek(data_start_ + (i - word_begin_)*sizeof(word_t));
+
+      for (auto* word = buf_, *end = buf_ + (buf_end_ - buf_begin_); word != end; ++word) {
+        *word = word_t(doc_in_->read_long());
+      }
+    }
+
+    return buf_[i - buf_begin_];
+  }
+
+  irs::attribute_view attrs_;
+  word_t buf_[BUF_SIZE]; // loaded chunk of the bitmap
+  word_t word_{}; // bits of the current word which are not visited yet
+  size_t next_word_{}; // index of the next word to visit
+  size_t word_begin_{}; // index of the first stored word
+  size_t word_end_{}; // index past the last stored word
+  size_t buf_begin_{}; // index of the first loaded word
+  size_t buf_end_{}; // index past the last loaded word
+  uint64_t data_start_{}; // file pointer to the first stored word
+  document doc_;
+  index_input::ptr doc_in_;
+}; // bitmap_doc_iterator
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @class mask_doc_iterator
 ///////////////////////////////////////////////////////////////////////////////
@@ -1379,14 +1978,21 @@ class pos_iterator: public position {
 
   // prepares iterator to work
   virtual void prepare(const doc_state& state) {
-    pos_in_ = state.pos_in->reopen();
-
     if (!pos_in_) {
-      IR_FRMT_FATAL("Failed to reopen positions input in: %s", __FUNCTION__);
+      pos_in_ = state.pos_in->reopen();
 
-      throw detailed_io_error("failed to reopen positions input");
+      if (!pos_in_) {
+        IR_FRMT_FATAL("Failed to reopen positions input in: %s", __FUNCTION__);
+
+        throw detailed_io_error("failed to reopen positions input");
+      }
     }
 
+    // drop the state of the previously iterated term since instances are pooled
+    clear();
+    pend_pos_ = 0;
+    buf_pos_ = postings_writer::BLOCK_SIZE;
+
     pos_in_->seek(state.term_state->pos_start);
     freq_ = state.freq;
     features_ = state.features;
@@ -1402,6 +2008,11 @@ class pos_iterator: public position {
     buf_pos_ = postings_writer::BLOCK_SIZE;
   }
 
+  // drops reopened inputs, i.e. idle pooled iterators don't hold file handles
+  virtual void release_inputs() NOEXCEPT {
+    pos_in_.reset();
+  }
+
   virtual uint32_t value() const override { return value_; }
 
  protected:
@@ -1492,17 +2103,25 @@ class offs_pay_iterator final: public pos_iterator {
 
   virtual void prepare(const doc_state& state) override {
     pos_iterator::prepare(state);
-    pay_in_ = state.pay_in->reopen();
 
     if (!pay_in_) {
-      IR_FRMT_FATAL("Failed to reopen payload input in: %s", __FUNCTION__);
+      pay_in_ = state.pay_in->reopen();
+
+      if (!pay_in_) {
+        IR_FRMT_FATAL("Failed to reopen payload input in: %s", __FUNCTION__);
 
-      throw detailed_io_error("failed to reopen payload input");
+        throw detailed_io_error("failed to reopen payload input");
+      }
     }
 
     pay_in_->seek(state.term_state->pay_start);
   }
 
+  virtual void release_inputs() NOEXCEPT override {
+    pos_iterator::release_inputs();
+    pay_in_.reset();
+  }
+
   virtual void prepare(const skip_state& state) override {
     pos_iterator::prepare(state);
     pay_in_->seek(state.pay_ptr);
@@ -1599,6 +2218,9 @@ class offs_pay_iterator final: public pos_iterator {
         #else
           pay_in_->read_bytes(&(pay_data_[0]), size);
         #endif // IRESEARCH_DEBUG
+      } else {
+        // no payloads in a block, lengths may be left from another term
+        std::fill_n(pay_lengths_, postings_writer::BLOCK_SIZE, 0);
       }
 
       // read offsets
@@ -1637,17 +2259,25 @@ class offs_iterator final : public pos_iterator {
 
   virtual void prepare(const doc_state& state) override {
     pos_iterator::prepare(state);
-    pay_in_ = state.pay_in->reopen();
 
     if (!pay_in_) {
-      IR_FRMT_FATAL("Failed to reopen payload input in: %s", __FUNCTION__);
+      pay_in_ = state.pay_in->reopen();
+
+      if (!pay_in_) {
+        IR_FRMT_FATAL("Failed to reopen payload input in: %s", __FUNCTION__);
 
-      throw detailed_io_error("failed to reopen payload input");
+        throw detailed_io_error("failed to reopen payload input");
+      }
     }
 
     pay_in_->seek(state.term_state->pay_start);
   }
 
+  virtual void release_inputs() NOEXCEPT override {
+    pos_iterator::release_inputs();
+    pay_in_.reset();
+  }
+
   virtual void prepare(const skip_state& state) override {
     pos_iterator::prepare(state);
     pay_in_->seek(state.pay_ptr);
@@ -1747,17 +2377,25 @@ class pay_iterator final : public pos_iterator {
 
   virtual void prepare(const doc_state& state) override {
     pos_iterator::prepare(state);
-    pay_in_ = state.pay_in->reopen();
 
     if (!pay_in_) {
-      IR_FRMT_FATAL("Failed to reopen payload input in: %s", __FUNCTION__);
+      pay_in_ = state.pay_in->reopen();
+
+      if (!pay_in_) {
+        IR_FRMT_FATAL("Failed to reopen payload input in: %s", __FUNCTION__);
 
-      throw detailed_io_error("failed to reopen payload input");
+        throw detailed_io_error("failed to reopen payload input");
+      }
     }
 
     pay_in_->seek(state.term_state->pay_start);
   }
 
+  virtual void release_inputs() NOEXCEPT override {
+    pos_iterator::release_inputs();
+    pay_in_.reset();
+  }
+
   virtual void prepare(const skip_state& state) override {
     pos_iterator::prepare(state);
     pay_in_->seek(state.pay_ptr);
@@ -1855,6 +2493,9 @@ class pay_iterator final : public pos_iterator {
         #else
           pay_in_->read_bytes(&(pay_data_[0]), size);
         #endif // IRESEARCH_DEBUG
+      } else {
+        // no payloads in a block, lengths may be left from another term
+        std::fill_n(pay_lengths_, postings_writer::BLOCK_SIZE, 0);
       }
 
       // skip offsets
@@ -1878,6 +2519,18 @@ class pay_iterator final : public pos_iterator {
 template<typename PosItrType>
 class pos_doc_iterator final: public doc_iterator {
  public:
+  virtual doc_id_t seek(doc_id_t target) override {
+    if (target <= doc_.value) {
+      return doc_.value;
+    }
+
+    seek_to_block(target);
+
+    // have to visit every document in order to track positions
+    iresearch::seek(*this, target);
+    return value();
+  }
+
   virtual bool next() override {
     if (begin_ == end_) {
       cur_pos_ += relative_pos();
@@ -1904,6 +2557,11 @@ class pos_doc_iterator final: public doc_iterator {
     return true;
   }
 
+  virtual void release_inputs() NOEXCEPT override final {
+    doc_iterator::release_inputs();
+    pos_.release_inputs();
+  }
+
  protected:
   virtual void prepare_attributes(
     const ::features& features,
@@ -4951,6 +5609,13 @@ NS_END // columns
 
 class postings_reader final: public irs::postings_reader {
  public:
+  // number of idle iterators of each type cached by the reader
+  static const size_t ITERATOR_POOL_SIZE = 8;
+
+  explicit postings_reader(doc_codec codec)
+    : codec_(codec) {
+  }
+
   virtual bool prepare(
     index_input& in,
     const reader_state& state,
@@ -4971,9 +5636,56 @@ class postings_reader final: public irs::postings_reader {
   ) override;
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @struct iterator_factory
+  /// @brief creates postings iterators of the specified type for a pool
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename IteratorImpl>
+  struct iterator_factory {
+    typedef typename IteratorImpl::ptr ptr;
+
+    static ptr make() {
+      return IteratorImpl::template make<IteratorImpl>();
+    }
+  }; // iterator_factory
+
+  template<typename IteratorImpl>
+  using iterator_pool = unbounded_object_pool_volatile<iterator_factory<IteratorImpl>>;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns an iterator from the specified pool, the iterator drops its
+  ///          reopened inputs before it is returned into the pool, so idle
+  ///          iterators never pin file handles (e.g. of 'fs_directory')
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename Pool>
+  static std::shared_ptr<typename Pool::element_type> acquire(Pool& pool) {
+    typedef typename Pool::element_type iterator_t;
+
+    auto it = make_move_on_copy(pool.emplace());
+    auto* raw = it.value().get();
+
+    return std::shared_ptr<iterator_t>(
+      raw,
+      [it](iterator_t* raw) mutable NOEXCEPT {
+        raw->release_inputs();
+        it.value().reset(); // return into the pool
+    });
+  }
+
+  // iterators along with their decode buffers and attributes are
+  // returned into the pools once released and reused for subsequent terms
+  iterator_pool<bitmap_doc_iterator> bitmap_pool_{ ITERATOR_POOL_SIZE };
+  iterator_pool<doc_iterator> doc_pool_{ ITERATOR_POOL_SIZE };
+  iterator_pool<pos_doc_iterator<pos_iterator>> pos_pool_{ ITERATOR_POOL_SIZE };
+  iterator_pool<pos_doc_iterator<offs_iterator>> offs_pool_{ ITERATOR_POOL_SIZE };
+  iterator_pool<pos_doc_iterator<pay_iterator>> pay_pool_{ ITERATOR_POOL_SIZE };
+  iterator_pool<pos_doc_iterator<offs_pay_iterator>> offs_pay_pool_{ ITERATOR_POOL_SIZE };
   index_input::ptr doc_in_;
   index_input::ptr pos_in_;
   index_input::ptr pay_in_;
+  doc_codec codec_; // encoding of document blocks
+  int32_t doc_version_{}; // version of document stream format
+  int32_t terms_version_{}; // version of term attributes format
 }; // postings_reader
 
 bool postings_reader::prepare(
@@ -4983,10 +5695,12 @@ bool postings_reader::prepare(
   std::string buf;
 
   // prepare document input
-  prepare_input(
+  doc_version_ = prepare_input(
     buf, doc_in_, irs::IOAdvice::RANDOM, state,
     postings_writer::DOC_EXT,
-    postings_writer::DOC_FORMAT_NAME,
+    doc_codec::ELIAS_FANO == codec_
+      ? postings_writer::DOC_EF_FORMAT_NAME
+      : postings_writer::DOC_FORMAT_NAME,
     postings_writer::FORMAT_MIN,
     postings_writer::FORMAT_MAX
   );
@@ -5035,7 +5749,7 @@ bool postings_reader::prepare(
   }
 
   // check postings format
-  format_utils::check_header(in,
+  terms_version_ = format_utils::check_header(in,
     postings_writer::TERMS_FORMAT_NAME,
     postings_writer::TERMS_FORMAT_MIN,
     postings_writer::TERMS_FORMAT_MAX
@@ -5067,7 +5781,13 @@ void postings_reader::decode(
 
   auto& term_freq = attrs.get<frequency>();
 
-  term_meta.docs_count = in.read_vint();
+  if (meta.check<frequency>() || terms_version_ < postings_writer::TERMS_FORMAT_BITMAP) {
+    term_meta.docs_count = in.read_vint();
+    term_meta.bitmap = false;
+  } else {
+    term_meta.bitmap = shift_unpack_32(in.read_vint(), term_meta.docs_count);
+  }
+
   if (term_freq) {
     term_freq->value = term_meta.docs_count + in.read_vint();
   }
@@ -5085,7 +5805,8 @@ void postings_reader::decode(
     }
   }
 
-  if (1U == term_meta.docs_count || term_meta.docs_count > postings_writer::BLOCK_SIZE) {
+  if (!term_meta.bitmap
+      && (1U == term_meta.docs_count || term_meta.docs_count > postings_writer::BLOCK_SIZE)) {
     term_meta.e_skip_start = in.read_vlong();
   }
 }
@@ -5105,29 +5826,39 @@ irs::doc_iterator::ptr postings_reader::iterator(
   // get enabled features:
   // find intersection between requested and available features
   const auto enabled = features & req;
-  doc_iterator::ptr it;
+
+  assert(attrs.contains<version10::term_meta>());
+  if (attrs.get<version10::term_meta>()->bitmap) {
+    // bitmaps are written for docs-only fields
+    auto it = acquire(bitmap_pool_);
+    it->prepare(attrs, doc_in_.get());
+
+    return IMPLICIT_MOVE_WORKAROUND(it);
+  }
+
+  std::shared_ptr<doc_iterator> it;
 
   // MSVC 2013 doesn't support constexpr, can't use
   // 'operator|' in the following switch statement
   switch (enabled) {
    case features::FREQ_POS_OFFS_PAY:
-    it = doc_iterator::make<pos_doc_iterator<offs_pay_iterator>>();
+    it = acquire(offs_pay_pool_);
     break;
    case features::FREQ_POS_OFFS:
-    it = doc_iterator::make<pos_doc_iterator<offs_iterator>>();
+    it = acquire(offs_pool_);
     break;
    case features::FREQ_POS_PAY:
-    it = doc_iterator::make<pos_doc_iterator<pay_iterator>>();
+    it = acquire(pay_pool_);
     break;
    case features::FREQ_POS:
-    it = doc_iterator::make<pos_doc_iterator<pos_iterator>>();
+    it = acquire(pos_pool_);
     break;
    default:
-    it = doc_iterator::make<doc_iterator>();
+    it = acquire(doc_pool_);
   }
 
   it->prepare(
-    features, enabled, attrs,
+    features, enabled, attrs, codec_, doc_version_,
     doc_in_.get(), pos_in_.get(), pay_in_.get()
   );
 
@@ -5167,10 +5898,17 @@ class format : public irs::version10::format {
 
   virtual postings_writer::ptr get_postings_writer(bool volatile_state) const override;
   virtual postings_reader::ptr get_postings_reader() const override;
+
+ protected:
+  explicit format(const irs::format::type_id& type) NOEXCEPT;
 };
 
 format::format() NOEXCEPT : irs::version10::format(format::type()) {}
 
+format::format(const irs::format::type_id& type) NOEXCEPT
+  : irs::version10::format(type) {
+}
+
 index_meta_writer::ptr format::get_index_meta_writer() const  {
   return irs::index_meta_writer::make<::index_meta_writer>();
 }
@@ -5240,11 +5978,13 @@ columnstore_reader::ptr format::get_columnstore_reader() const {
 }
 
 irs::postings_writer::ptr format::get_postings_writer(bool volatile_state) const {
-  return irs::postings_writer::make<::postings_writer>(volatile_state);
+  return irs::postings_writer::make<::postings_writer>(
+    volatile_state, doc_codec::BITPACK
+  );
 }
 
 irs::postings_reader::ptr format::get_postings_reader() const {
-  return irs::postings_reader::make<::postings_reader>();
+  return irs::postings_reader::make<::postings_reader>(doc_codec::BITPACK);
 }
 
 /*static*/ irs::format::ptr format::make() {
@@ -5257,6 +5997,41 @@ irs::postings_reader::ptr format::get_postings_reader() const {
 DEFINE_FORMAT_TYPE_NAMED(::format, format_traits::NAME);
 REGISTER_FORMAT(::format);
 
+// same as 'format' but stores full document blocks
+// as partitioned Elias-Fano sequences or bitmaps
+class format_ef final : public format {
+ public:
+  DECLARE_FORMAT_TYPE();
+  DECLARE_FACTORY();
+
+  format_ef() NOEXCEPT;
+
+  virtual postings_writer::ptr get_postings_writer(bool volatile_state) const override;
+  virtual postings_reader::ptr get_postings_reader() const override;
+};
+
+format_ef::format_ef() NOEXCEPT : format(format_ef::type()) {}
+
+irs::postings_writer::ptr format_ef::get_postings_writer(bool volatile_state) const {
+  return irs::postings_writer::make<::postings_writer>(
+    volatile_state, doc_codec::ELIAS_FANO
+  );
+}
+
+irs::postings_reader::ptr format_ef::get_postings_reader() const {
+  return irs::postings_reader::make<::postings_reader>(doc_codec::ELIAS_FANO);
+}
+
+/*static*/ irs::format::ptr format_ef::make() {
+  static const ::format_ef INSTANCE;
+
+  // aliasing constructor
+  return irs::format::ptr(irs::format::ptr(), &INSTANCE);
+}
+
+DEFINE_FORMAT_TYPE_NAMED(::format_ef, format_traits::EF_NAME);
+REGISTER_FORMAT(::format_ef);
+
 NS_END
 
 NS_ROOT
@@ -5265,6 +6040,7 @@ NS_BEGIN(version10)
 void init() {
 #ifndef IRESEARCH_DLL
   REGISTER_FORMAT(::format);
+  REGISTER_FORMAT(::format_ef);
 #endif
 }
 
@@ -334,6 +334,11 @@ void skip_reader::reset() {
   std::for_each(levels_.begin(), levels_.end(), reset);
 }
 
+void skip_reader::release() NOEXCEPT {
+  levels_.clear();
+  read_ = nullptr;
+}
+
 void skip_reader::load_level(levels_t& levels, index_input::ptr&& stream, size_t step) {
   // read level length
   const auto length = stream->read_vlong();
@@ -352,9 +357,9 @@ void skip_reader::load_level(levels_t& levels, index_input::ptr&& stream, size_t
 void skip_reader::prepare(index_input::ptr&& in, const read_f& read /* = nop */) {
   // read number of levels in a skip-list
   size_t max_levels = in->read_vint();
+  std::vector<level> levels; // levels of the previously prepared list are dropped
 
   if (max_levels) {
-    std::vector<level> levels;
     levels.reserve(max_levels);
 
     size_t step = skip_0_ * size_t(pow(skip_n_, --max_levels)); // skip step of the level
@@ -372,11 +377,11 @@ void skip_reader::prepare(index_input::ptr&& in, const read_f& read /* = nop */)
     // load 0 level
     load_level(levels, std::move(in), skip_0_);
     levels.back().child = UNDEFINED;
-
-    // noexcept
-    levels_ = std::move(levels);
   }
 
+  // noexcept
+  levels_ = std::move(levels);
+
   // noexcept
   read_ = read;
 }
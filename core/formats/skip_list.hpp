@@ -188,6 +188,12 @@ class IRESEARCH_API skip_reader: util::noncopyable {
   //////////////////////////////////////////////////////////////////////////////
   void reset();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief drops the input streams of a prepared skip-list, skip_reader has
+  ///        to be prepared again afterwards
+  //////////////////////////////////////////////////////////////////////////////
+  void release() NOEXCEPT;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @returns true if skip_reader was succesfully prepared
   //////////////////////////////////////////////////////////////////////////////
@@ -188,6 +188,16 @@ class directory_reader_impl :
     const index_reader::ptr& cached = nullptr
   );
 
+  // open a new directory reader over the segments of the specified meta
+  // if meta_file_ref != nullptr then it is retained by the reader
+  // if cached != nullptr then try to reuse its segments
+  static index_reader::ptr open(
+    const directory& dir,
+    index_meta&& meta,
+    const index_file_refs::ref_t& meta_file_ref,
+    const index_reader::ptr& cached = nullptr
+  );
+
  private:
   typedef std::unordered_set<index_file_refs::ref_t> segment_file_refs_t;
   typedef std::vector<segment_file_refs_t> reader_file_refs_t;
@@ -231,6 +241,20 @@ directory_reader& directory_reader::operator=(
   return directory_reader_impl::open(dir, codec.get());
 }
 
+/*static*/ directory_reader directory_reader::open(
+    const directory& dir,
+    const index_meta& meta,
+    const directory_reader& cached /*= directory_reader()*/) {
+  index_meta meta_copy(meta);
+
+  return directory_reader_impl::open(
+    dir,
+    std::move(meta_copy),
+    nullptr, // no index meta file to retain
+    atomic_utils::atomic_load(&cached.impl_)
+  );
+}
+
 directory_reader directory_reader::reopen(
     format::ptr codec /*= nullptr*/) const {
   // make a copy
@@ -274,6 +298,14 @@ directory_reader_impl::directory_reader_impl(
     throw index_not_found();
   }
 
+  return open(dir, std::move(meta), meta_file_ref, cached);
+}
+
+/*static*/ index_reader::ptr directory_reader_impl::open(
+    const directory& dir,
+    index_meta&& meta,
+    const index_file_refs::ref_t& meta_file_ref,
+    const index_reader::ptr& cached /*= nullptr*/) {
 #ifdef IRESEARCH_DEBUG
   auto* cached_impl = dynamic_cast<const directory_reader_impl*>(cached.get());
   assert(!cached || cached_impl);
@@ -313,8 +345,9 @@ directory_reader_impl::directory_reader_impl(
     auto itr = reuse_candidates.find(segment.name);
 
     if (itr != reuse_candidates.end()
-        && itr->second != INVALID_CANDIDATE
-        && segment == cached_impl->meta().segment(itr->second).meta) {
+        && itr->second != INVALID_CANDIDATE) {
+      // reuses the cached reader as is if unchanged, shares its immutable
+      // state if only the document mask changed, opens a new one otherwise
       ctx.reader = (*cached_impl)[itr->second].reopen(segment);
       reuse_candidates.erase(itr);
     } else {
@@ -337,7 +370,9 @@ directory_reader_impl::directory_reader_impl(
   }
 
   directory_utils::reference(const_cast<directory&>(dir), meta, visitor, true);
-  tmp_file_refs.emplace(meta_file_ref);
+  if (meta_file_ref) {
+    tmp_file_refs.emplace(meta_file_ref);
+  }
   file_refs.back().swap(tmp_file_refs); // use last position for storing index_meta refs
 
   PTR_NAMED(
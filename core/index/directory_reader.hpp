@@ -86,6 +86,18 @@ class IRESEARCH_API directory_reader final
     format::ptr codec = nullptr
   );
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief create an index reader over the segments of the specified meta
+  ///        without loading an index meta file from the directory, e.g. over
+  ///        segments flushed by an index_writer but not yet committed
+  ///        this call will atempt to reuse segments from 'cached' (if any)
+  ////////////////////////////////////////////////////////////////////////////////
+  static directory_reader open(
+    const directory& dir,
+    const index_meta& meta,
+    const directory_reader& cached = directory_reader()
+  );
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief open a new instance based on the latest file for the specified codec
   ///        this call will atempt to reuse segments from the existing reader
@@ -26,6 +26,8 @@
 #include "merge_writer.hpp"
 #include "formats/format_utils.hpp"
 #include "search/exclusion.hpp"
+#include "search/term_filter.hpp"
+#include "store/store_utils.hpp"
 #include "utils/bitset.hpp"
 #include "utils/bitvector.hpp"
 #include "utils/directory_utils.hpp"
@@ -37,6 +39,7 @@
 #include "index_writer.hpp"
 
 #include <list>
+#include <map>
 #include <sstream>
 
 NS_LOCAL
@@ -87,6 +90,258 @@ std::vector<irs::index_file_refs::ref_t> extract_refs(
   return refs;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invoke 'fn' for every element of 'items' on the specified 'pool' and
+///        wait for all invocations to finish
+/// @param pool where to run invocations, nullptr == run on the current thread
+/// @note rethrows the exception of the first failed invocation (if any)
+////////////////////////////////////////////////////////////////////////////////
+template<typename Items, typename Func>
+void parallel_for_each(
+    irs::async_utils::task_scheduler* pool,
+    irs::async_utils::task_scheduler::priority prio,
+    Items& items,
+    const Func& fn
+) {
+  if (!pool || items.size() < 2) {
+    for (auto& item : items) {
+      fn(item);
+    }
+
+    return;
+  }
+
+  irs::async_utils::task_scheduler::task_group group(pool, prio);
+
+  for (auto& item : items) {
+    group.run([&fn, &item]()->void { fn(item); });
+  }
+
+  group.wait(); // the current thread takes part in evaluation
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @return true if files of the specified segment may be copied as-is into a
+///         segment written in the specified format, i.e. formats match and all
+///         segment file names are derived from the segment name
+////////////////////////////////////////////////////////////////////////////////
+bool is_copyable(
+    const irs::segment_meta& meta,
+    const irs::format& codec
+) NOEXCEPT {
+  if (!meta.codec || meta.codec->type() != codec.type()) {
+    return false;
+  }
+
+  for (auto& file : meta.files) {
+    if (!irs::starts_with(file, irs::string_ref(meta.name))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool copy_file(
+    const irs::directory& src,
+    const std::string& src_name,
+    irs::directory& dst,
+    const std::string& dst_name
+) {
+  auto in = src.open(src_name, irs::IOAdvice::READONCE_SEQUENTIAL);
+
+  if (!in) {
+    IR_FRMT_ERROR("Failed to open file '%s' for copying", src_name.c_str());
+
+    return false;
+  }
+
+  auto out = dst.create(dst_name);
+
+  if (!out) {
+    IR_FRMT_ERROR("Failed to create file '%s' for copying", dst_name.c_str());
+
+    return false;
+  }
+
+  irs::byte_type buf[65536]; // arbitrary size
+
+  for (auto left = in->length(); left;) {
+    const auto read = in->read_bytes(buf, std::min(left, sizeof buf));
+
+    if (!read) {
+      IR_FRMT_ERROR("Failed to read file '%s' for copying", src_name.c_str());
+
+      return false;
+    }
+
+    out->write_bytes(buf, read);
+    left -= read;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief copy files of the 'src' segment to the 'segment' as-is, file names
+///        are derived from the name of 'segment'
+////////////////////////////////////////////////////////////////////////////////
+bool copy_segment(
+    irs::index_meta::index_segment_t& segment,
+    irs::directory& dst,
+    const irs::directory& src_dir,
+    const irs::segment_meta& src
+) {
+  auto& meta = segment.meta;
+
+  meta.docs_count = src.docs_count;
+  meta.live_docs_count = src.live_docs_count;
+  meta.column_store = src.column_store;
+  meta.version = src.version; // document mask file name depends on version
+  meta.files.clear();
+
+  for (auto& src_name : src.files) {
+    auto dst_name = meta.name + src_name.substr(src.name.size());
+
+    if (!copy_file(src_dir, src_name, dst, dst_name)) {
+      return false;
+    }
+
+    meta.files.emplace(std::move(dst_name));
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief resolves modification filters against a single segment
+/// @note 'by_term' filters are batched: terms of the same field are sorted and
+///       looked up in a single pass over the field's term dictionary, only the
+///       seek cookies are retained, postings are opened lazily in modification
+///       order so that generation/'seen' semantics stay unchanged
+////////////////////////////////////////////////////////////////////////////////
+class modification_iterators : private irs::util::noncopyable {
+ public:
+  modification_iterators(
+      const irs::sub_reader& reader,
+      const modification_contexts_ref& modifications
+  ): reader_(reader),
+     modifications_(modifications),
+     lookup_(modifications.size(), FALLBACK) {
+    std::vector<size_t> batch; // offsets of batchable modifications
+
+    for (size_t i = 0, size = modifications.size(); i < size; ++i) {
+      auto& filter = modifications[i].filter;
+
+      if (filter && filter->type() == irs::by_term::type()) {
+        batch.emplace_back(i);
+      }
+    }
+
+    if (batch.empty()) {
+      return;
+    }
+
+    std::sort(
+      batch.begin(), batch.end(),
+      [&modifications](size_t lhs, size_t rhs) {
+        auto& lhs_filter = static_cast<const irs::by_term&>(*modifications[lhs].filter);
+        auto& rhs_filter = static_cast<const irs::by_term&>(*modifications[rhs].filter);
+        const int cmp = lhs_filter.field().compare(rhs_filter.field());
+
+        return cmp < 0 || (0 == cmp && lhs_filter.term() < rhs_filter.term());
+    });
+
+    const irs::by_term* prev = nullptr;
+    irs::seek_term_iterator* terms = nullptr;
+    size_t last = 0; // offset of the last distinct batched modification
+
+    for (auto i : batch) {
+      auto& filter = static_cast<const irs::by_term&>(*modifications[i].filter);
+      const bool same_field = prev && prev->field() == filter.field();
+
+      if (same_field && prev->term() == filter.term()) {
+        lookup_[i] = lookup_[last];
+        continue; // duplicate term, share the lookup result
+      }
+
+      prev = &filter;
+
+      if (!same_field) {
+        auto* field = reader.field(filter.field());
+
+        terms_.emplace_back(field ? field->iterator() : nullptr);
+        terms = terms_.back().get();
+      }
+
+      last = i;
+
+      if (!terms || !terms->seek(filter.term())) {
+        lookup_[i] = MISSING;
+        continue;
+      }
+
+      terms->read(); // read term attributes
+      states_.emplace_back(terms, terms->cookie());
+      lookup_[i] = states_.size() - 1;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @return iterator over documents matched by the modification at offset
+  ///         'i', nullptr if nothing matched
+  ////////////////////////////////////////////////////////////////////////////
+  irs::doc_iterator::ptr execute(size_t i) const {
+    const auto& modification = modifications_[i];
+
+    if (!modification.filter) {
+      return nullptr; // skip invalid or uncommitted modification queries
+    }
+
+    const auto state_id = lookup_[i];
+
+    if (MISSING == state_id) {
+      return nullptr; // term is not present in the segment
+    }
+
+    if (FALLBACK == state_id) {
+      auto prepared = modification.filter->prepare(reader_);
+
+      return prepared ? prepared->execute(reader_) : nullptr;
+    }
+
+    auto& state = states_[state_id];
+
+    // cookie based seek does not require the relatively expensive FST traversal
+    if (!state.terms->seek(irs::bytes_ref::NIL, *state.cookie)) {
+      return nullptr;
+    }
+
+    return state.terms->postings(irs::flags::empty_instance());
+  }
+
+ private:
+  static const size_t MISSING = irs::integer_traits<size_t>::const_max;
+  static const size_t FALLBACK = MISSING - 1;
+
+  struct term_state {
+    term_state(
+        irs::seek_term_iterator* terms,
+        irs::seek_term_iterator::cookie_ptr&& cookie
+    ) NOEXCEPT: terms(terms), cookie(std::move(cookie)) {
+    }
+
+    irs::seek_term_iterator* terms;
+    irs::seek_term_iterator::cookie_ptr cookie;
+  };
+
+  const irs::sub_reader& reader_;
+  const modification_contexts_ref modifications_;
+  std::vector<irs::seek_term_iterator::ptr> terms_; // one per batched field
+  std::vector<term_state> states_; // one per distinct found term
+  std::vector<size_t> lookup_; // modification offset -> offset in 'states_'
+}; // modification_iterators
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief apply any document removals based on filters in the segment
 /// @param modifications where to get document update_contexts from
@@ -118,21 +373,14 @@ bool add_document_mask_modified_records(
 
   bool modified = false;
 
-  for (auto& modification : modifications) {
-    if (!modification.filter) {
-      continue; // skip invalid or uncommitted modification queries
-    }
+  modification_iterators iterators(reader, modifications);
 
-    auto prepared = modification.filter->prepare(reader);
-
-    if (!prepared) {
-      continue; // skip invalid prepared filters
-    }
-
-    auto itr = prepared->execute(reader);
+  for (size_t i = 0, size = modifications.size(); i < size; ++i) {
+    auto& modification = modifications[i];
+    auto itr = iterators.execute(i);
 
     if (!itr) {
-      continue; // skip invalid iterators
+      continue; // skip invalid modification queries or iterators
     }
 
     while (itr->next()) {
@@ -147,7 +395,7 @@ bool add_document_mask_modified_records(
 
       assert(meta.live_docs_count);
       --meta.live_docs_count; // decrement count of live docs
-      modification.seen = true;
+      modification.seen.store(true);
       modified = true;
     }
   }
@@ -186,21 +434,14 @@ bool add_document_mask_modified_records(
   assert(ctx.doc_id_end_ <= ctx.update_contexts_.size() + doc_limits::min());
   bool modified = false;
 
-  for (auto& modification : modifications) {
-    if (!modification.filter) {
-      continue; // skip invalid or uncommitted modification queries
-    }
+  modification_iterators iterators(reader, modifications);
 
-    auto prepared = modification.filter->prepare(reader);
-
-    if (!prepared) {
-      continue; // skip invalid prepared filters
-    }
-
-    auto itr = prepared->execute(reader);
+  for (size_t i = 0, size = modifications.size(); i < size; ++i) {
+    auto& modification = modifications[i];
+    auto itr = iterators.execute(i);
 
     if (!itr) {
-      continue; // skip invalid iterators
+      continue; // skip invalid modification queries or iterators
     }
 
     while (itr->next()) {
@@ -431,17 +672,24 @@ segment_reader readers_cache::emplace(const segment_meta& meta) {
 
   segment_reader cached_reader;
 
-  // FIXME consider moving open/reopen out of the scope of the lock
-  SCOPED_LOCK(lock_);
-  auto& reader = cache_[meta.name];
+  {
+    SCOPED_LOCK(lock_);
+    auto it = cache_.find(meta.name);
 
-  cached_reader = std::move(reader); // clear existing reader
+    if (it != cache_.end()) {
+      cached_reader = std::move(it->second); // clear existing reader
+    }
+  }
 
-  // update cache, in case of failure reader stays empty
-  reader = cached_reader
+  // open/reopen outside of the lock so that independent segments may be
+  // opened concurrently, in case of failure cached reader stays empty
+  auto reader = cached_reader
     ? cached_reader.reopen(meta)
     : segment_reader::open(dir_, meta);
 
+  SCOPED_LOCK(lock_);
+  cache_[meta.name] = reader; // update cache
+
   return reader;
 }
 
@@ -473,6 +721,79 @@ size_t readers_cache::purge(
   return erased;
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                       ttl_context implementation
+// ----------------------------------------------------------------------------
+
+index_writer::ttl_context::ttl_context(const options& opts)
+  : column(opts.ttl_column),
+    partition(opts.ttl_partition),
+    watermark(integer_traits<int64_t>::const_min) {
+}
+
+bool index_writer::ttl_context::bounds(
+    int64_t& min,
+    int64_t& max,
+    bool& complete,
+    const segment_meta& meta,
+    readers_cache& readers) {
+  assert(enabled());
+
+  {
+    SCOPED_LOCK(lock);
+    auto it = cache.find(meta.name);
+
+    if (it != cache.end()) {
+      std::tie(min, max, complete) = it->second;
+
+      return min <= max;
+    }
+  }
+
+  // evaluate outside of the lock so that independent segments may be
+  // evaluated concurrently, segments are immutable hence evaluated only once
+  min = integer_traits<int64_t>::const_max;
+  max = integer_traits<int64_t>::const_min;
+
+  auto reader = readers.emplace(meta);
+  const auto* column = reader ? reader.column_reader(this->column) : nullptr;
+
+  if (!reader) {
+    return false; // do not cache, segment may become readable later
+  }
+
+  uint64_t count = 0; // documents having a timestamp
+
+  if (column) {
+    column->visit([&min, &max, &count](doc_id_t, const bytes_ref& value) {
+      bytes_ref_input in(value);
+      const auto timestamp = read_zvlong(in);
+
+      min = std::min(min, timestamp);
+      max = std::max(max, timestamp);
+      ++count;
+
+      return true;
+    });
+  }
+
+  complete = count >= meta.docs_count;
+
+  SCOPED_LOCK(lock);
+  cache.emplace(meta.name, std::make_tuple(min, max, complete));
+
+  return min <= max;
+}
+
+void index_writer::ttl_context::purge(
+    const std::unordered_set<std::string>& segments) NOEXCEPT {
+  SCOPED_LOCK(lock);
+
+  for (auto& segment : segments) {
+    cache.erase(segment);
+  }
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                      index_writer implementation
 // ----------------------------------------------------------------------------
@@ -859,6 +1180,7 @@ void index_writer::flush_context::reset() NOEXCEPT {
 
 index_writer::segment_context::segment_context(
     directory& dir,
+    size_t compound_file_max,
     segment_meta_generator_t&& meta_generator
 ): active_count_(0),
    buffered_docs_(0),
@@ -868,7 +1190,7 @@ index_writer::segment_context::segment_context(
    uncomitted_doc_id_begin_(doc_limits::min()),
    uncomitted_generation_offset_(0),
    uncomitted_modification_queries_(0),
-   writer_(segment_writer::make(dir_)) {
+   writer_(segment_writer::make(dir_, compound_file_max)) {
   assert(meta_generator_);
 }
 
@@ -909,9 +1231,12 @@ bool index_writer::segment_context::flush() {
 
 index_writer::segment_context::ptr index_writer::segment_context::make(
     directory& dir,
+    size_t compound_file_max,
     segment_meta_generator_t&& meta_generator
 ) {
-  return memory::make_shared<segment_context>(dir, std::move(meta_generator));
+  return memory::make_shared<segment_context>(
+    dir, compound_file_max, std::move(meta_generator)
+  );
 }
 
 segment_writer::update_context index_writer::segment_context::make_update_context() {
@@ -1028,18 +1353,23 @@ index_writer::index_writer(
     directory& dir,
     format::ptr codec,
     size_t segment_pool_size,
+    std::unique_ptr<async_utils::task_scheduler>&& flush_pool,
     const segment_limits& segment_limits,
+    const options& opts,
     index_meta&& meta,
     committed_state_t&& committed_state
-) NOEXCEPT:
+):
     cached_readers_(dir),
     codec_(codec),
     committed_state_(std::move(committed_state)),
     dir_(dir),
+    flush_pool_(std::move(flush_pool)),
+    commit_pool_(1, 1), // a dedicated thread since commit() itself may wait on 'flush_pool_'
     flush_context_pool_(2), // 2 because just swap them due to common commit lock
     meta_(std::move(meta)),
     segment_limits_(segment_limits),
     segment_writer_pool_(segment_pool_size),
+    ttl_(opts),
     segments_active_(0),
     writer_(codec->get_index_meta_writer()),
     write_lock_(std::move(lock)),
@@ -1169,6 +1499,15 @@ index_writer::ptr index_writer::make(
     std::move(file_refs)
   );
 
+  std::unique_ptr<async_utils::task_scheduler> flush_pool;
+
+  if (opts.flush_pool_size) {
+    async_utils::task_scheduler::options pool_opts;
+
+    pool_opts.threads = opts.flush_pool_size;
+    flush_pool = memory::make_unique<async_utils::task_scheduler>(pool_opts);
+  }
+
   PTR_NAMED(
     index_writer,
     writer,
@@ -1177,7 +1516,9 @@ index_writer::ptr index_writer::make(
     dir,
     codec,
     opts.segment_pool_size,
+    std::move(flush_pool),
     segment_limits(opts),
+    opts,
     std::move(meta),
     std::move(comitted_state)
   );
@@ -1196,6 +1537,7 @@ index_writer::~index_writer() {
 }
 
 void index_writer::close() {
+  commit_pool_.stop(); // finish pending commit_async() requests
   cached_readers_.clear(); // cached_readers_ read/modified during flush()
   write_lock_.reset();
 }
@@ -1238,7 +1580,12 @@ bool index_writer::consolidate(
   // collect a list of consolidation candidates
   {
     SCOPED_LOCK(consolidation_lock_);
-    policy(candidates, *committed_meta, consolidating_segments_);
+
+    if (ttl_.enabled() && ttl_.partition) {
+      partitioned_candidates(candidates, policy, *committed_meta);
+    } else {
+      policy(candidates, *committed_meta, consolidating_segments_);
+    }
 
     switch (candidates.size()) {
       case 0:
@@ -1340,6 +1687,10 @@ bool index_writer::consolidate(
     return false; // nothing to consolidate or consolidation failure
   }
 
+  index_utils::pack_segment(
+    dir, consolidation_segment.meta, segment_limits_.compound_file_max
+  );
+
   // commit merge
   {
     SCOPED_LOCK_NAMED(commit_lock_, lock); // ensure committed_state_ segments are not modified by concurrent consolidate()/commit()
@@ -1474,52 +1825,249 @@ bool index_writer::consolidate(
   return true;
 }
 
+struct index_writer::import_group {
+  std::vector<const sub_reader*> readers; // segments to merge
+  const directory* dir{}; // directory of 'source'
+  const segment_meta* source{}; // segment to copy as-is (if not nullptr)
+  index_meta::index_segment_t segment; // imported segment
+  file_refs_t refs; // references to files of the imported segment
+}; // import_group
+
 bool index_writer::import(
     const index_reader& reader,
     format::ptr codec /*= nullptr*/,
     const merge_writer::flush_progress_t& progress /*= {}*/
 ) {
-  if (!reader.live_docs_count()) {
-    return true; // skip empty readers since no documents to import
+  import_options opts;
+
+  opts.codec = codec;
+  opts.progress = progress;
+
+  return import(reader, opts);
+}
+
+bool index_writer::import(
+    const index_reader& reader,
+    const import_options& opts
+) {
+  std::vector<import_group> groups;
+  const auto group_size = opts.segments_per_group
+    ? opts.segments_per_group
+    : reader.size();
+
+  for (auto& segment : reader) {
+    if (!segment.live_docs_count()) {
+      continue; // skip empty segments since no documents to import
+    }
+
+    if (groups.empty() || groups.back().readers.size() >= group_size) {
+      groups.emplace_back();
+      groups.back().readers.reserve(group_size);
+    }
+
+    groups.back().readers.emplace_back(&segment);
   }
 
-  if (!codec) {
-    codec = codec_;
+  return import(groups, opts);
+}
+
+bool index_writer::import(
+    const directory& dir,
+    const index_meta& meta,
+    const import_options& opts
+) {
+  const auto& codec = opts.codec ? opts.codec : codec_;
+  std::vector<segment_reader> readers;
+  std::vector<import_group> groups;
+
+  readers.reserve(meta.size()); // ensure stable addresses of readers
+
+  for (auto& segment : meta) {
+    if (!segment.meta.live_docs_count) {
+      continue; // skip empty segments since no documents to import
+    }
+
+    if (opts.copy_segments && is_copyable(segment.meta, *codec)) {
+      groups.emplace_back();
+      groups.back().dir = &dir;
+      groups.back().source = &segment.meta;
+      continue;
+    }
+
+    readers.emplace_back(segment_reader::open(dir, segment.meta));
+
+    if (!readers.back()) {
+      IR_FRMT_ERROR(
+        "Failed to open segment '%s' for import",
+        segment.meta.name.c_str()
+      );
+
+      return false;
+    }
   }
 
-  ref_tracking_directory dir(dir_); // track references
+  // reuse grouping of reader import for segments which have to be merged
+  const auto group_size = opts.segments_per_group
+    ? opts.segments_per_group
+    : readers.size();
 
-  index_meta::index_segment_t segment;
-  segment.meta.name = file_name(meta_.increment());
-  segment.meta.codec = codec;
+  for (size_t i = 0, count = readers.size(); i < count; ++i) {
+    if (0 == i % group_size) {
+      groups.emplace_back();
+      groups.back().readers.reserve(group_size);
+    }
 
-  merge_writer merger(dir);
-  merger.reserve(reader.size());
+    groups.back().readers.emplace_back(&*readers[i]);
+  }
 
-  for (auto& segment : reader) {
-    merger.add(segment);
+  return import(groups, opts);
+}
+
+bool index_writer::import(
+    std::vector<import_group>& groups,
+    const import_options& opts
+) {
+  if (groups.empty()) {
+    return true; // nothing to import
   }
 
-  if (!merger.flush(segment, progress)) {
-    return false; // import failure (no files created, nothing to clean up)
+  auto codec = opts.codec ? opts.codec : codec_;
+
+  for (auto& group : groups) {
+    group.segment.meta.name = file_name(meta_.increment());
+    group.segment.meta.codec = codec;
   }
 
-  index_utils::write_index_segment(dir, segment);
+  std::atomic<bool> imported(true);
+
+  parallel_for_each(
+    flush_pool_.get(),
+    async_utils::task_scheduler::priority::MERGE,
+    groups,
+    [this, &imported, &opts](import_group& group) {
+      if (!imported.load()) {
+        return; // import already failed, do not waste resources
+      }
 
-  auto refs = extract_refs(dir);
+      ref_tracking_directory dir(dir_); // track references
+
+      if (group.source) {
+        if (!copy_segment(group.segment, dir, *group.dir, *group.source)) {
+          imported.store(false);
+          return; // partially copied files will be cleaned up
+        }
+      } else {
+        merge_writer merger(dir);
+        merger.reserve(group.readers.size());
+
+        for (auto* segment : group.readers) {
+          merger.add(*segment);
+        }
+
+        if (!merger.flush(group.segment, opts.progress)) {
+          imported.store(false);
+          return; // import failure (no files created, nothing to clean up)
+        }
+      }
+
+      index_utils::pack_segment(
+        dir, group.segment.meta, segment_limits_.compound_file_max
+      );
+      index_utils::write_index_segment(dir, group.segment);
+      group.refs = extract_refs(dir);
+  });
+
+  if (!imported.load()) {
+    return false;
+  }
 
   auto ctx = get_flush_context();
   SCOPED_LOCK(ctx->mutex_); // lock due to context modification
 
-  ctx->pending_segments_.emplace_back(
-    std::move(segment),
-    ctx->generation_.load(), // current modification generation
-    std::move(refs) // do not forget to track refs
-  );
+  // register all segments within the same flush context, i.e. the same commit
+  ctx->pending_segments_.reserve(ctx->pending_segments_.size() + groups.size());
+
+  for (auto& group : groups) {
+    ctx->pending_segments_.emplace_back(
+      std::move(group.segment),
+      ctx->generation_.load(), // current modification generation
+      std::move(group.refs) // do not forget to track refs
+    );
+  }
+
+  return true;
+}
+
+bool index_writer::expire(int64_t timestamp) NOEXCEPT {
+  if (!ttl_.enabled()) {
+    return false;
+  }
+
+  auto watermark = ttl_.watermark.load();
+
+  while (watermark < timestamp
+         && !ttl_.watermark.compare_exchange_weak(watermark, timestamp)) {
+  }
 
   return true;
 }
 
+void index_writer::partitioned_candidates(
+    std::set<const segment_meta*>& candidates,
+    const consolidation_policy_t& policy,
+    const index_meta& meta) {
+  std::map<int64_t, index_meta> partitions; // ordered, oldest first
+  index_meta unpartitioned; // segments without timestamps
+
+  for (auto& segment : meta) {
+    int64_t min, max;
+    bool complete;
+    auto& partition = ttl_.bounds(min, max, complete, segment.meta, cached_readers_)
+      ? partitions[max < 0 ? (max + 1) / int64_t(ttl_.partition) - 1 // floor
+                           : max / int64_t(ttl_.partition)]
+      : unpartitioned;
+
+    partition.segments_.emplace_back(segment);
+  }
+
+  std::unordered_map<string_ref, const segment_meta*> segments;
+
+  for (auto& segment : meta) {
+    segments.emplace(segment.meta.name, &segment.meta);
+  }
+
+  // policy is evaluated per partition, the first partition with something to
+  // consolidate wins, consolidating_segments_ lookup is by segment name
+  auto select = [&](const index_meta& partition)->bool {
+    std::set<const segment_meta*> selected;
+
+    policy(selected, partition, consolidating_segments_);
+
+    if (selected.empty()
+        || (1 == selected.size()
+            && *selected.begin()
+            && (*selected.begin())->live_docs_count == (*selected.begin())->docs_count)) {
+      return false; // nothing to consolidate within the partition
+    }
+
+    for (auto* segment : selected) {
+      auto it = segment ? segments.find(segment->name) : segments.end();
+
+      candidates.emplace(it == segments.end() ? nullptr : it->second);
+    }
+
+    return true;
+  };
+
+  for (auto& partition : partitions) {
+    if (select(partition.second)) {
+      return;
+    }
+  }
+
+  select(unpartitioned);
+}
+
 index_writer::flush_context_ptr index_writer::get_flush_context(bool shared /*= true*/) {
   auto* ctx = flush_context_.load(); // get current ctx
 
@@ -1614,14 +2162,17 @@ index_writer::active_segment_context index_writer::get_segment_context(
     return segment_meta(file_name(meta_.increment()), codec_);
   };
   auto segment_ctx =
-    segment_writer_pool_.emplace(dir_, std::move(meta_generator)).release();
+    segment_writer_pool_.emplace(
+      dir_, segment_limits_.compound_file_max, std::move(meta_generator)
+    ).release();
 
   return active_segment_context(segment_ctx, segments_active_);
 }
 
 index_writer::pending_context_t index_writer::flush_all() {
   REGISTER_TIMER_DETAILED();
-  bool modified = !type_limits<type_t::index_gen_t>::valid(meta_.last_gen_);
+  bool modified = !type_limits<type_t::index_gen_t>::valid(meta_.last_gen_)
+    || !unsynced_refs_.empty(); // segments flushed by reader() were not committed yet
   sync_context to_sync;
   document_mask docs_mask;
 
@@ -1658,12 +2209,27 @@ index_writer::pending_context_t index_writer::flush_all() {
 
     // FIXME TODO flush_all() blocks flush_context::emplace(...) and insert()/remove()/replace()
     segment_flush_locks.emplace_back(entry.segment_->flush_mutex_); // prevent concurrent modification of segment_context properties during flush_context::emplace(...)
+  }
 
-    // force a flush of the underlying segment_writer
-    if (!entry.segment_->flush()) {
-      return pending_context_t(); // failed to flush segment
-    }
+  // force a flush of the underlying segment_writers, segment_writers are
+  // independent of each other and are flushed concurrently if possible
+  std::atomic<bool> flushed(true);
 
+  parallel_for_each(
+    flush_pool_.get(),
+    async_utils::task_scheduler::priority::FLUSH,
+    ctx->pending_segment_contexts_,
+    [&flushed](flush_context::pending_segment_context& entry) {
+      if (!entry.segment_->flush()) {
+        flushed.store(false); // failed to flush segment
+      }
+  });
+
+  if (!flushed.load()) {
+    return pending_context_t(); // failed to flush segment
+  }
+
+  for (auto& entry: ctx->pending_segment_contexts_) {
     entry.doc_id_end_ =
       std::min(entry.segment_->uncomitted_doc_id_begin_, entry.doc_id_end_); // update so that can use valid value below
     entry.modification_offset_end_ = std::min(
@@ -1677,19 +2243,67 @@ index_writer::pending_context_t index_writer::flush_all() {
   /// update document_mask for existing (i.e. sealed) segments
   /////////////////////////////////////////////////////////////////////////////
 
+  // segments are independent of each other, every task owns a copy of its
+  // segment and its document_mask, results are merged in 'meta_' order below
+  struct existing_segment_context {
+    explicit existing_segment_context(const index_meta::index_segment_t& segment)
+      : segment(segment) {
+    }
+
+    index_meta::index_segment_t segment;
+    document_mask docs_mask;
+    bool mask_modified{false};
+    bool expired{false}; // all timestamps below the TTL watermark
+  };
+
+  std::vector<existing_segment_context> existing_segments;
+
   for (auto& existing_segment: meta_) {
     // skip already masked segments
     if (ctx->segment_mask_.end() != ctx->segment_mask_.find(existing_segment.meta.name)) {
       continue;
     }
 
-    const auto segment_id = segments.size();
-    segments.emplace_back(existing_segment);
+    existing_segments.emplace_back(existing_segment);
+  }
 
-    auto mask_modified = false;
-    auto& segment = segments.back();
+  const auto ttl_watermark = ttl_.enabled()
+    ? ttl_.watermark.load()
+    : integer_traits<int64_t>::const_min;
+
+  // updates have to be evaluated against expired segments as well, otherwise
+  // a replacement of an expired document is considered unused and masked
+  bool pending_updates = false;
+
+  for (auto& modifications: ctx->pending_segment_contexts_) {
+    const auto& queries = modifications.segment_->modification_queries_;
+
+    for (auto i = modifications.modification_offset_begin_,
+              end = modifications.modification_offset_end_;
+         i < end && !pending_updates; ++i) {
+      pending_updates = queries[i].update;
+    }
+  }
+
+  auto mask_existing_segment = [&ctx, &dir, ttl_watermark, pending_updates, this](existing_segment_context& entry) {
+    auto& segment = entry.segment;
+    auto& docs_mask = entry.docs_mask;
+    auto& mask_modified = entry.mask_modified;
+    int64_t min, max;
+    bool complete;
+
+    // drop the whole segment, documents without a timestamp keep it alive
+    entry.expired = ttl_watermark != integer_traits<int64_t>::const_min
+      && ttl_.bounds(min, max, complete, segment.meta, cached_readers_)
+      && complete
+      && max < ttl_watermark;
+
+    // no need to evaluate any filters against an expired segment unless
+    // there are updates, whose 'seen' flag must still be set
+    if (entry.expired && !pending_updates) {
+      return;
+    }
 
-    docs_mask.clear();
     index_utils::read_document_mask(docs_mask, dir, segment.meta);
 
     // mask documents matching filters from segment_contexts (i.e. from new operations)
@@ -1713,20 +2327,44 @@ index_writer::pending_context_t index_writer::flush_all() {
       );
     }
 
+    // the mask of an expired segment is never written
+    if (entry.expired) {
+      docs_mask.clear();
+      mask_modified = false;
+    }
+  };
+
+  parallel_for_each(
+    flush_pool_.get(),
+    async_utils::task_scheduler::priority::FLUSH,
+    existing_segments,
+    mask_existing_segment
+  );
+
+  for (auto& entry: existing_segments) {
+    auto& segment = entry.segment;
+
+    if (entry.expired) {
+      ctx->segment_mask_.emplace(segment.meta.name); // mask segment to clear reader cache
+      modified = true; // removal of one fo the existing segments
+      continue;
+    }
+
     // write docs_mask if masks added, if all docs are masked then mask segment
-    if (mask_modified) {
+    if (entry.mask_modified) {
       // mask empty segments
       if (!segment.meta.live_docs_count) {
-        ctx->segment_mask_.emplace(existing_segment.meta.name); // mask segment to clear reader cache
-        segments.pop_back(); // remove empty segment
+        ctx->segment_mask_.emplace(segment.meta.name); // mask segment to clear reader cache
         modified = true; // removal of one fo the existing segments
         continue;
       }
 
-      to_sync.register_partial_sync(segment_id, write_document_mask(dir, segment.meta, docs_mask));
+      to_sync.register_partial_sync(segments.size(), write_document_mask(dir, segment.meta, entry.docs_mask));
       segment.meta.size = 0; // reset for new write
       index_utils::write_index_segment(dir, segment); // write with new mask
     }
+
+    segments.emplace_back(std::move(segment));
   }
 
   /////////////////////////////////////////////////////////////////////////////
@@ -2024,6 +2662,7 @@ index_writer::pending_context_t index_writer::flush_all() {
 
   pending_meta->update_generation(meta_); // clone index metadata generation
   cached_readers_.purge(ctx->segment_mask_); // release cached readers
+  ttl_.purge(ctx->segment_mask_); // release cached timestamps
 
   modified |= !to_sync.empty(); // new files added
 
@@ -2072,6 +2711,11 @@ bool index_writer::start() {
     throw illegal_state();
   }
 
+  // track all refs
+  file_refs_t pending_refs;
+
+  append_segments_refs(pending_refs, dir, pending_meta);
+
   // sync all pending files
   try {
     auto update_generation = make_finally([this, &pending_meta] {
@@ -2091,6 +2735,21 @@ bool index_writer::start() {
 
     // sync files
     to_commit.to_sync.visit(sync, pending_meta);
+
+    // sync files flushed by reader() that are still referenced
+    if (!unsynced_refs_.empty()) {
+      std::unordered_set<string_ref> unsynced;
+
+      for (auto& ref : unsynced_refs_) {
+        unsynced.emplace(*ref);
+      }
+
+      for (auto& ref : pending_refs) {
+        if (unsynced.end() != unsynced.find(*ref)) {
+          sync(*ref);
+        }
+      }
+    }
   } catch (...) {
     // in case of syncing error, just clear pending meta & peform rollback
     // next commit will create another meta & sync all pending files
@@ -2099,13 +2758,10 @@ bool index_writer::start() {
     throw;
   }
 
-  // track all refs
-  file_refs_t pending_refs;
-
-  append_segments_refs(pending_refs, dir, pending_meta);
   pending_refs.emplace_back(
     directory_utils::reference(dir, writer_->filename(pending_meta), true)
   );
+  unsynced_refs_.clear(); // all referenced files have been synced above
 
   // 1st phase of the transaction successfully finished here,
   // set to_commit as active flush context containing pending meta
@@ -2150,11 +2806,60 @@ void index_writer::commit() {
   finish();
 }
 
-void index_writer::rollback() {
+directory_reader index_writer::reader(
+    const directory_reader& cached /*= directory_reader()*/) {
   SCOPED_LOCK(commit_lock_);
 
+  // a started transaction already holds the flushed state
   if (!pending_state_) {
-    // there is no open transaction
+    auto to_flush = flush_all();
+
+    if (to_flush) {
+      // retain files of the flushed state until they are synced by commit(),
+      // files already referenced by the last commit are synced
+      std::unordered_set<string_ref> tracked;
+
+      for (auto& ref : committed_state_->second) {
+        tracked.emplace(*ref);
+      }
+
+      for (auto& ref : unsynced_refs_) {
+        tracked.emplace(*ref);
+      }
+
+      file_refs_t refs;
+
+      append_segments_refs(refs, *to_flush.ctx->dir_, *to_flush.meta);
+
+      for (auto& ref : refs) {
+        if (tracked.emplace(*ref).second) {
+          unsynced_refs_.emplace_back(std::move(ref));
+        }
+      }
+    }
+  }
+
+  return directory_reader::open(dir_, meta_, cached);
+}
+
+std::future<void> index_writer::commit_async() {
+  auto task = make_move_on_copy(
+    std::packaged_task<void()>([this]()->void { commit(); })
+  );
+  auto result = task.value().get_future();
+
+  if (!commit_pool_.run([task]() mutable ->void { task.value()(); })) {
+    throw illegal_state(); // writer has been closed
+  }
+
+  return result;
+}
+
+void index_writer::rollback() {
+  SCOPED_LOCK(commit_lock_);
+
+  if (!pending_state_ && unsynced_refs_.empty()) {
+    // there is no open transaction and nothing flushed by reader()
     return;
   }
 
@@ -2165,6 +2870,7 @@ void index_writer::rollback() {
   // guarded by commit_lock_
   writer_->rollback();
   pending_state_.reset();
+  unsynced_refs_.clear(); // segments flushed by reader() are rolled back too
 
   // reset actual meta, note that here we don't change
   // segment counters since it can be changed from insert function
@@ -24,6 +24,7 @@
 #ifndef IRESEARCH_INDEXWRITER_H
 #define IRESEARCH_INDEXWRITER_H
 
+#include "directory_reader.hpp"
 #include "field_meta.hpp"
 #include "index_meta.hpp"
 #include "merge_writer.hpp"
@@ -42,6 +43,8 @@
 
 #include <cassert>
 #include <atomic>
+#include <future>
+#include <tuple>
 
 NS_ROOT
 
@@ -362,7 +365,7 @@ class IRESEARCH_API index_writer:
     filter_ptr filter; // keep a handle to the filter for the case when this object has ownership
     const size_t generation;
     const bool update; // this is an update modification (as opposed to remove)
-    bool seen;
+    std::atomic<bool> seen; // may be set concurrently while evaluating independent segments
     modification_context(const irs::filter& match_filter, size_t gen, bool isUpdate)
       : filter(filter_ptr(), &match_filter), generation(gen), update(isUpdate), seen(false) {}
     modification_context(const filter_ptr& match_filter, size_t gen, bool isUpdate)
@@ -370,7 +373,7 @@ class IRESEARCH_API index_writer:
     modification_context(irs::filter::ptr&& match_filter, size_t gen, bool isUpdate)
       : filter(std::move(match_filter)), generation(gen), update(isUpdate), seen(false) {}
     modification_context(modification_context&& other) NOEXCEPT
-      : filter(std::move(other.filter)), generation(other.generation), update(other.update), seen(other.seen) {}
+      : filter(std::move(other.filter)), generation(other.generation), update(other.update), seen(other.seen.load()) {}
     modification_context& operator=(const modification_context& other) = delete; // no default constructor
   };
 
@@ -419,9 +422,76 @@ class IRESEARCH_API index_writer:
     ////////////////////////////////////////////////////////////////////////////
     size_t segment_pool_size{128}; // arbitrary size
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief number of threads used during commit to evaluate modification
+    ///        queries against independent segments and during import to
+    ///        build independent segments
+    ///        0 == evaluate on the committing/importing thread
+    ////////////////////////////////////////////////////////////////////////////
+    size_t flush_pool_size{0};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief pack files of flushed, consolidated and imported segments into a
+    ///        single compound file if their total size does not exceed this
+    ///        byte limit, i.e. reduce the number of open files for small and
+    ///        medium segments
+    ///        0 == never pack
+    ////////////////////////////////////////////////////////////////////////////
+    size_t compound_file_max{0};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief name of the stored column holding a timestamp of every document
+    ///        encoded via write_zvlong(...), enables whole-segment expiry via
+    ///        expire(...) and time partitioned consolidation
+    ///        empty == TTL disabled
+    ////////////////////////////////////////////////////////////////////////////
+    std::string ttl_column;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief width of a time partition in units of 'ttl_column' timestamps,
+    ///        a segment belongs to the partition of its max timestamp and
+    ///        consolidation never merges segments of different partitions
+    ///        0 == do not partition
+    ////////////////////////////////////////////////////////////////////////////
+    uint64_t ttl_partition{0};
+
     options() {}; // GCC5 requires non-default definition
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief options the import is performed with
+  //////////////////////////////////////////////////////////////////////////////
+  struct import_options {
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief desired format that will be used for segment creation
+    ///        nullptr == use index_writer's codec
+    ////////////////////////////////////////////////////////////////////////////
+    format::ptr codec;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief callback triggered for consolidation steps, if the callback
+    ///        returns false then import is aborted
+    /// @note invoked concurrently if segments are imported on the flush pool
+    ////////////////////////////////////////////////////////////////////////////
+    merge_writer::flush_progress_t progress;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief maximum number of source segments merged into a single new
+    ///        segment, groups of source segments are merged concurrently on
+    ///        the flush pool (if any)
+    ///        0 == merge all source segments into a single new segment
+    ////////////////////////////////////////////////////////////////////////////
+    size_t segments_per_group{0};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief copy files of source segments written in the desired format
+    ///        as-is instead of merging them (applicable to directory import)
+    ////////////////////////////////////////////////////////////////////////////
+    bool copy_segments{false};
+
+    import_options() {}; // GCC5 requires non-default definition
+  };
+
   struct segment_hash {
     size_t operator()(
         const segment_meta* segment
@@ -515,6 +585,16 @@ class IRESEARCH_API index_writer:
     return documents_context(*this);
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief drop whole segments with all timestamps of 'options::ttl_column'
+  ///        less than the specified one starting with the next commit, i.e.
+  ///        neither removal filters are evaluated nor document masks written
+  /// @note the watermark only grows, segments having documents without a
+  ///       timestamp never expire
+  /// @return false if TTL is not enabled for the writer
+  ////////////////////////////////////////////////////////////////////////////
+  bool expire(int64_t timestamp) NOEXCEPT;
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief imports index from the specified index reader into new segment
   /// @param reader the index reader to import 
@@ -530,6 +610,28 @@ class IRESEARCH_API index_writer:
     const merge_writer::flush_progress_t& progress = {}
   );
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief imports index from the specified index reader into new segments,
+  ///        all new segments become visible with the same commit
+  /// @param reader the index reader to import
+  /// @returns true on success
+  ////////////////////////////////////////////////////////////////////////////
+  bool import(const index_reader& reader, const import_options& opts);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief imports segments of the specified index meta from the specified
+  ///        directory into new segments, all new segments become visible with
+  ///        the same commit
+  /// @param dir the directory containing the segments to import
+  /// @param meta the index meta referencing the segments to import
+  /// @returns true on success
+  ////////////////////////////////////////////////////////////////////////////
+  bool import(
+    const directory& dir,
+    const index_meta& meta,
+    const import_options& opts
+  );
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief opens new index writer
   /// @param dir directory where index will be should reside
@@ -563,6 +665,30 @@ class IRESEARCH_API index_writer:
   ////////////////////////////////////////////////////////////////////////////
   void commit();
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief make all buffered changes visible for readers without blocking
+  ///        the calling thread, documents inserted while the commit is in
+  ///        progress become part of the next commit
+  /// @return future that becomes ready once the commit has finished,
+  ///         future::get() rethrows any failure of the commit
+  /// @note commits are run one at a time in the order of submission by a
+  ///       single background thread owned by the writer, discarding the
+  ///       returned future neither waits for nor cancels the commit,
+  ///       close() waits for all pending commits
+  ////////////////////////////////////////////////////////////////////////////
+  std::future<void> commit_async();
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief flush all buffered changes to the directory and return a reader
+  ///        over them without a durable commit, i.e. neither files are synced
+  ///        nor a new index meta is written, changes become durable with the
+  ///        next commit() and are discarded by rollback()
+  /// @param cached reader to reuse segment readers from (if any)
+  /// @note while a transaction is started via begin() the reader covers the
+  ///       state of that transaction
+  ////////////////////////////////////////////////////////////////////////////
+  directory_reader reader(const directory_reader& cached = directory_reader());
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief closes writer object 
   ////////////////////////////////////////////////////////////////////////////
@@ -732,8 +858,8 @@ class IRESEARCH_API index_writer:
     segment_writer::ptr writer_;
     index_meta::index_segment_t writer_meta_; // the segment_meta this writer was initialized with
 
-    DECLARE_FACTORY(directory& dir, segment_meta_generator_t&& meta_generator)
-    segment_context(directory& dir, segment_meta_generator_t&& meta_generator);
+    DECLARE_FACTORY(directory& dir, size_t compound_file_max, segment_meta_generator_t&& meta_generator)
+    segment_context(directory& dir, size_t compound_file_max, segment_meta_generator_t&& meta_generator);
 
     ////////////////////////////////////////////////////////////////////////////
     /// @brief flush current writer state into a materialized segment
@@ -769,13 +895,45 @@ class IRESEARCH_API index_writer:
     size_t segment_count_max; // @see options::max_segment_count
     size_t segment_docs_max; // @see options::max_segment_docs
     size_t segment_memory_max; // @see options::max_segment_memory
+    size_t compound_file_max; // @see options::compound_file_max
     segment_limits(const options& opts) NOEXCEPT
       : segment_count_max(opts.segment_count_max),
         segment_docs_max(opts.segment_docs_max),
-        segment_memory_max(opts.segment_memory_max) {
+        segment_memory_max(opts.segment_memory_max),
+        compound_file_max(opts.compound_file_max) {
     }
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief timestamp bounds of segments with respect to options::ttl_column
+  //////////////////////////////////////////////////////////////////////////////
+  struct ttl_context : util::noncopyable {
+    explicit ttl_context(const options& opts);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief [min, max] timestamps of all documents in the segment, evaluated
+    ///        once per segment
+    /// @param complete every document of the segment has a timestamp
+    /// @return false if the segment has no timestamps
+    ////////////////////////////////////////////////////////////////////////////
+    bool bounds(
+      int64_t& min,
+      int64_t& max,
+      bool& complete,
+      const segment_meta& meta,
+      readers_cache& readers
+    );
+
+    bool enabled() const NOEXCEPT { return !column.empty(); }
+    void purge(const std::unordered_set<std::string>& segments) NOEXCEPT;
+
+    std::string column; // @see options::ttl_column
+    uint64_t partition; // @see options::ttl_partition
+    std::atomic<int64_t> watermark; // segments with all timestamps below are expired
+    std::mutex lock; // guard for 'cache'
+    std::unordered_map<std::string, std::tuple<int64_t, int64_t, bool>> cache; // [min, max], complete by segment name
+  }; // ttl_context
+
   typedef std::shared_ptr<
     std::pair<std::shared_ptr<index_meta>,
     file_refs_t
@@ -934,13 +1092,26 @@ class IRESEARCH_API index_writer:
     directory& dir, 
     format::ptr codec,
     size_t segment_pool_size,
+    std::unique_ptr<async_utils::task_scheduler>&& flush_pool,
     const segment_limits& segment_limits,
+    const options& opts,
     index_meta&& meta, 
     committed_state_t&& committed_state
-  ) NOEXCEPT;
+  );
+
+  struct import_group; // source segments of a single new segment
 
   pending_context_t flush_all();
 
+  // selects consolidation candidates within a single time partition
+  void partitioned_candidates(
+    std::set<const segment_meta*>& candidates,
+    const consolidation_policy_t& policy,
+    const index_meta& meta
+  );
+
+  bool import(std::vector<import_group>& groups, const import_options& opts);
+
   flush_context_ptr get_flush_context(bool shared = true);
   active_segment_context get_segment_context(flush_context& ctx); // return a usable segment or a nullptr segment if retry is required (e.g. no free segments available)
 
@@ -955,13 +1126,17 @@ class IRESEARCH_API index_writer:
   std::recursive_mutex consolidation_lock_;
   consolidating_segments_t consolidating_segments_; // segments that are under consolidation
   directory& dir_; // directory used for initialization of readers
+  std::unique_ptr<async_utils::task_scheduler> flush_pool_; // evaluates per-segment work during commit, nullptr == use committing thread
+  async_utils::thread_pool commit_pool_; // a single thread running commit_async() requests
   std::vector<flush_context> flush_context_pool_; // collection of contexts that collect data to be flushed, 2 because just swap them
   std::atomic<flush_context*> flush_context_; // currently active context accumulating data to be processed during the next flush
   index_meta meta_; // latest/active state of index metadata
   pending_state_t pending_state_; // current state awaiting commit completion
   segment_limits segment_limits_; // limits for use with respect to segments
   segment_pool_t segment_writer_pool_; // a cache of segments available for reuse
+  ttl_context ttl_; // segment timestamps for expiry and time partitioning
   std::atomic<size_t> segments_active_; // number of segments currently in use by the writer
+  file_refs_t unsynced_refs_; // files flushed by reader() not yet synced by commit()
   index_meta_writer::ptr writer_;
   index_lock::ptr write_lock_; // exclusive write lock for directory
   index_file_refs::ref_t write_lock_file_ref_; // track ref for lock file to preven removal
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "reader_manager.hpp"
+#include "utils/directory_utils.hpp"
+#include "utils/log.hpp"
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                     reader_manager implementation
+// -----------------------------------------------------------------------------
+
+/*static*/ reader_manager::ptr reader_manager::make(
+    directory& dir,
+    format::ptr codec /*= nullptr*/,
+    const options& opts /*= options()*/) {
+  if (opts.cleanup && !codec) {
+    throw illegal_argument(); // current segments are resolved via codec
+  }
+
+  auto reader = directory_reader::open(dir, codec);
+
+  PTR_NAMED(
+    reader_manager,
+    manager,
+    dir,
+    codec,
+    opts,
+    std::move(reader)
+  );
+
+  if (opts.refresh_interval.count()) {
+    manager->thread_ = std::thread(&reader_manager::run, manager.get());
+  }
+
+  return manager;
+}
+
+reader_manager::reader_manager(
+    directory& dir,
+    format::ptr codec,
+    const options& opts,
+    directory_reader&& reader)
+  : codec_(codec),
+    dir_(dir),
+    opts_(opts),
+    reader_(std::move(reader)) {
+}
+
+reader_manager::~reader_manager() {
+  {
+    SCOPED_LOCK(lock_);
+    stop_ = true;
+  }
+
+  cond_.notify_all();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+bool reader_manager::refresh() {
+  SCOPED_LOCK(refresh_lock_);
+
+  auto reader = acquire();
+  auto new_reader = reader.reopen(codec_); // reuses unchanged segments
+
+  if (new_reader == reader) {
+    return false; // no changes to publish
+  }
+
+  reader_ = new_reader; // atomic store, readers in use are not affected
+  reader.reset(); // release own reference to the previous snapshot
+
+  if (opts_.cleanup) {
+    // files of previous snapshots which are still in use are referenced
+    directory_cleaner::clean(
+      dir_, directory_utils::remove_except_current_segments(dir_, *codec_)
+    );
+  }
+
+  return true;
+}
+
+void reader_manager::run() {
+  std::unique_lock<std::mutex> lock(lock_);
+
+  while (!stop_) {
+    cond_.wait_for(lock, opts_.refresh_interval);
+
+    if (stop_) {
+      break;
+    }
+
+    lock.unlock();
+
+    try {
+      refresh();
+    } catch (...) {
+      IR_LOG_EXCEPTION(); // keep serving the current snapshot
+    }
+
+    lock.lock();
+  }
+}
+
+NS_END
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_READER_MANAGER_H
+#define IRESEARCH_READER_MANAGER_H
+
+#include "directory_reader.hpp"
+#include "utils/noncopyable.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class reader_manager
+/// @brief holds the latest directory_reader snapshot of an index
+///        snapshots are acquired without blocking on a concurrent refresh,
+///        files of a snapshot stay referenced until its last copy is released
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API reader_manager : private util::noncopyable {
+ public:
+  DECLARE_SHARED_PTR(reader_manager);
+
+  struct options {
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief interval between refreshes done by a background thread
+    ///        0 == no background refresh, i.e. only explicit refresh()
+    ////////////////////////////////////////////////////////////////////////////
+    std::chrono::milliseconds refresh_interval{0};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief remove files which are neither referenced by any snapshot nor
+    ///        by the current index meta after every published refresh
+    /// @note requires a codec
+    ////////////////////////////////////////////////////////////////////////////
+    bool cleanup{false};
+
+    options() {}; // GCC5 requires non-default definition
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief opens a manager over the latest index in the directory
+  ///        if codec == nullptr then use the latest file for all known codecs
+  ////////////////////////////////////////////////////////////////////////////
+  static ptr make(
+    directory& dir,
+    format::ptr codec = nullptr,
+    const options& opts = options()
+  );
+
+  ~reader_manager();
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @return the current snapshot, the snapshot is released together with
+  ///         the last copy of the returned reader
+  ////////////////////////////////////////////////////////////////////////////
+  directory_reader acquire() const NOEXCEPT {
+    return reader_; // atomic copy
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief reopen the current snapshot and publish it if the index changed
+  /// @return true if a new snapshot was published
+  ////////////////////////////////////////////////////////////////////////////
+  bool refresh();
+
+ private:
+  reader_manager(
+    directory& dir,
+    format::ptr codec,
+    const options& opts,
+    directory_reader&& reader
+  );
+
+  void run(); // background refresh loop
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  format::ptr codec_;
+  std::condition_variable cond_; // signals background thread termination
+  directory& dir_;
+  std::mutex lock_; // guards 'stop_'
+  options opts_;
+  directory_reader reader_; // current snapshot, copied/assigned atomically
+  std::mutex refresh_lock_; // serializes concurrent refresh() calls
+  bool stop_{false};
+  std::thread thread_; // background refresh thread (if any)
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // reader_manager
+
+NS_END
+
+#endif
@@ -29,6 +29,7 @@
 #include "index/index_meta.hpp"
 
 #include "formats/format_utils.hpp"
+#include "store/compound_directory.hpp"
 #include "utils/index_utils.hpp"
 #include "utils/singleton.hpp"
 #include "utils/type_limits.hpp"
@@ -166,6 +167,23 @@ class masked_docs_iterator
   iresearch::doc_id_t next_;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @return files of the specified segment except its document mask
+////////////////////////////////////////////////////////////////////////////////
+irs::segment_meta::file_set data_files(const irs::segment_meta& meta) {
+  auto files = meta.files;
+
+  if (meta.codec) {
+    auto writer = meta.codec->get_document_mask_writer();
+
+    if (writer) {
+      files.erase(writer->filename(meta));
+    }
+  }
+
+  return files;
+}
+
 bool read_columns_meta(
     const iresearch::format& codec,
     const iresearch::directory& dir,
@@ -235,6 +253,10 @@ class segment_reader_impl : public sub_reader {
     const segment_meta& meta
   );
 
+  // open a reader over the specified version of the same segment, immutable
+  // segment state is shared if only the document mask differs
+  sub_reader::ptr reopen(const segment_meta& meta) const;
+
   const directory& dir() const NOEXCEPT { 
     return dir_;
   }
@@ -261,11 +283,11 @@ class segment_reader_impl : public sub_reader {
   }
 
   virtual const term_reader* field(const string_ref& name) const override {
-    return field_reader_->field(name);
+    return data_->fields->field(name);
   }
 
   virtual field_iterator::ptr fields() const override {
-    return field_reader_->iterator();
+    return data_->fields->iterator();
   }
 
   virtual uint64_t live_docs_count() const NOEXCEPT override {
@@ -291,15 +313,24 @@ class segment_reader_impl : public sub_reader {
 
  private:
   DECLARE_SHARED_PTR(segment_reader_impl); // required for NAMED_PTR(...)
-  std::vector<column_meta> columns_;
-  columnstore_reader::ptr columnstore_reader_;
+
+  // immutable segment state shared between readers over versions of the same
+  // segment which differ only in their document mask
+  struct segment_data {
+    directory::ptr compound; // view over the compound file (if any)
+    std::vector<column_meta> columns;
+    columnstore_reader::ptr columnstore;
+    segment_meta::file_set files; // segment files except document mask
+    field_reader::ptr fields;
+    std::vector<column_meta*> id_to_column;
+    std::unordered_map<hashed_string_ref, column_meta*> name_to_column;
+  };
+
+  std::shared_ptr<const segment_data> data_;
   const directory& dir_;
   uint64_t docs_count_;
   document_mask docs_mask_;
-  field_reader::ptr field_reader_;
-  std::vector<column_meta*> id_to_column_;
   uint64_t meta_version_;
-  std::unordered_map<hashed_string_ref, column_meta*> name_to_column_;
 
   segment_reader_impl(
     const directory& dir,
@@ -360,7 +391,7 @@ segment_reader segment_reader::reopen(const segment_meta& meta) const {
   // reuse self if no changes to meta
   return reader_impl.meta_version() == meta.version
     ? *this
-    : segment_reader_impl::open(reader_impl.dir(), meta);
+    : reader_impl.reopen(meta);
 }
 
 // -------------------------------------------------------------------
@@ -378,8 +409,9 @@ segment_reader_impl::segment_reader_impl(
 
 const column_meta* segment_reader_impl::column(
     const string_ref& name) const {
-  auto it = name_to_column_.find(make_hashed_ref(name, std::hash<irs::string_ref>()));
-  return it == name_to_column_.end() ? nullptr : it->second;
+  auto& name_to_column = data_->name_to_column;
+  auto it = name_to_column.find(make_hashed_ref(name, std::hash<irs::string_ref>()));
+  return it == name_to_column.end() ? nullptr : it->second;
 }
 
 column_iterator::ptr segment_reader_impl::columns() const {
@@ -396,7 +428,7 @@ column_iterator::ptr segment_reader_impl::columns() const {
   > iterator_t;
 
   auto it = memory::make_unique<iterator_t>(
-    columns_.data(), columns_.data() + columns_.size()
+    data_->columns.data(), data_->columns.data() + data_->columns.size()
   );
 
   return memory::make_managed<column_iterator>(std::move(it));
@@ -422,40 +454,74 @@ doc_iterator::ptr segment_reader_impl::docs_iterator() const {
   index_utils::read_document_mask(reader->docs_mask_, dir, meta);
 
   auto& codec = *meta.codec;
+  auto data = memory::make_shared<segment_data>();
+  auto* data_dir = &dir;
+
+  // data files of a packed segment are served by its compound file
+  if (meta.files.end() != meta.files.find(compound_directory::file_name(meta.name))) {
+    data->compound = compound_directory::open(dir, meta.name);
+
+    if (!data->compound) {
+      return nullptr;
+    }
+
+    data_dir = data->compound.get();
+  }
+
   auto field_reader = codec.get_field_reader();
 
   // initialize field reader
-  if (!field_reader->prepare(dir, meta, reader->docs_mask_)) {
+  if (!field_reader->prepare(*data_dir, meta, reader->docs_mask_)) {
     return nullptr; // i.e. nullptr, field reader required
   }
 
-  reader->field_reader_ = std::move(field_reader);
+  data->fields = std::move(field_reader);
 
   auto columnstore_reader = codec.get_columnstore_reader();
 
   // initialize column reader (if available)
   if (segment_reader::has<irs::columnstore_reader>(meta)
-      && columnstore_reader->prepare(dir, meta)) {
-    reader->columnstore_reader_ = std::move(columnstore_reader);
+      && columnstore_reader->prepare(*data_dir, meta)) {
+    data->columnstore = std::move(columnstore_reader);
   }
 
   // initialize columns meta
   read_columns_meta(
     codec,
-    dir,
+    *data_dir,
     meta,
-    reader->columns_,
-    reader->id_to_column_,
-    reader->name_to_column_
+    data->columns,
+    data->id_to_column,
+    data->name_to_column
   );
 
+  data->files = data_files(meta);
+  reader->data_ = std::move(data);
+
+  return reader;
+}
+
+sub_reader::ptr segment_reader_impl::reopen(const segment_meta& meta) const {
+  // data files (e.g. terms, postings, columns) are immutable, a segment version
+  // having the same data files may differ only in its document mask
+  if (meta.docs_count != docs_count_
+      || !meta.codec
+      || data_->files != data_files(meta)) {
+    return open(dir_, meta);
+  }
+
+  PTR_NAMED(segment_reader_impl, reader, dir_, meta.version, meta.docs_count);
+
+  index_utils::read_document_mask(reader->docs_mask_, dir_, meta);
+  reader->data_ = data_; // share immutable state
+
   return reader;
 }
 
 const columnstore_reader::column_reader* segment_reader_impl::column_reader(
     field_id field) const {
-  return columnstore_reader_
-    ? columnstore_reader_->column(field)
+  return data_->columnstore
+    ? data_->columnstore->column(field)
     : nullptr;
 }
 
@@ -69,9 +69,11 @@ doc_id_t segment_writer::begin(
   return doc_id_t(docs_cached() + type_limits<type_t::doc_id_t>::min() - 1); // -1 for 0-based offset
 }
 
-segment_writer::ptr segment_writer::make(directory& dir) {
+segment_writer::ptr segment_writer::make(
+    directory& dir,
+    size_t compound_file_max /*= 0*/) {
   // can't use make_unique becuase of the private constructor
-  return memory::maker<segment_writer>::make(dir);
+  return memory::maker<segment_writer>::make(dir, compound_file_max);
 }
 
 size_t segment_writer::memory_active() const NOEXCEPT {
@@ -105,8 +107,10 @@ bool segment_writer::remove(doc_id_t doc_id) {
   return true;
 }
 
-segment_writer::segment_writer(directory& dir) NOEXCEPT
-  : dir_(dir), initialized_(false) {
+segment_writer::segment_writer(
+    directory& dir,
+    size_t compound_file_max) NOEXCEPT
+  : dir_(dir), compound_file_max_(compound_file_max), initialized_(false) {
 }
 
 bool segment_writer::index(
@@ -250,6 +254,8 @@ bool segment_writer::flush(index_meta::index_segment_t& segment) {
     return false;
   }
 
+  index_utils::pack_segment(dir_, meta, compound_file_max_);
+
   // flush segment metadata
   index_utils::write_index_segment(dir_, segment);
 
@@ -155,7 +155,9 @@ class IRESEARCH_API segment_writer: util::noncopyable {
   }; // document
 
   DECLARE_UNIQUE_PTR(segment_writer);
-  DECLARE_FACTORY(directory& dir);
+  // @param compound_file_max pack flushed segments up to this size into a
+  //        compound file, 0 == never
+  DECLARE_FACTORY(directory& dir, size_t compound_file_max = 0);
 
   struct update_context {
     size_t generation;
@@ -245,7 +247,7 @@ class IRESEARCH_API segment_writer: util::noncopyable {
     columnstore_writer::column_t handle;
   };
 
-  segment_writer(directory& dir) NOEXCEPT;
+  segment_writer(directory& dir, size_t compound_file_max) NOEXCEPT;
 
   bool index(
     const hashed_string_ref& name,
@@ -343,6 +345,7 @@ class IRESEARCH_API segment_writer: util::noncopyable {
   column_meta_writer::ptr col_meta_writer_;
   columnstore_writer::ptr col_writer_;
   tracking_directory dir_;
+  size_t compound_file_max_; // @see make(...)
   bool initialized_;
   bool valid_{ true }; // current state
   IRESEARCH_API_PRIVATE_VARIABLES_END
@@ -1016,7 +1016,7 @@ store_reader store_reader::reopen() const {
   #endif
 
   {
-    async_utils::read_write_mutex::read_mutex mutex(reader_impl.store_.mutex_);
+    async_utils::distributed_read_write_mutex::read_mutex mutex(reader_impl.store_.mutex_);
     SCOPED_LOCK(mutex);
 
     if (reader_impl.store_.generation_ == reader_impl.generation_) {
@@ -1039,13 +1039,13 @@ void store_writer::bstring_output::write(const byte_type* value, size_t size) {
 
 store_writer::store_writer(transaction_store& store) NOEXCEPT
   : next_doc_id_(type_limits<type_t::doc_id_t>::min()), store_(store) {
-  async_utils::read_write_mutex::write_mutex mutex(store_.mutex_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(store_.mutex_);
   SCOPED_LOCK(mutex);
   const_cast<transaction_store::reusable_t&>(reusable_) = store.reusable_; // init under lock
 }
 
 store_writer::~store_writer() {
-  async_utils::read_write_mutex::write_mutex mutex(store_.mutex_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(store_.mutex_);
   SCOPED_LOCK(mutex);
 
   // invalidate in 'store_.valid_doc_ids_' anything in 'used_doc_ids_'
@@ -1057,7 +1057,7 @@ bool store_writer::commit() {
 
   // ensure doc_ids held by the transaction are always released
   auto cleanup = irs::make_finally([this]()->void {
-    async_utils::read_write_mutex::write_mutex mutex(store_.mutex_);
+    async_utils::distributed_read_write_mutex::write_mutex mutex(store_.mutex_);
     SCOPED_LOCK(mutex); // reobtain lock, ok since 'store_.commit_flush_mutex_' held
 
     // invalidate in 'store_.valid_doc_ids_' anything still in 'used_doc_ids_'
@@ -1077,7 +1077,7 @@ bool store_writer::commit() {
   if (!modification_queries_.empty()) {
     modified_lock.lock(); // prevent concurrent removals/updates (ensure reader stays valid until store state update is complete)
 
-    async_utils::read_write_mutex::read_mutex mutex(store_.mutex_);
+    async_utils::distributed_read_write_mutex::read_mutex mutex(store_.mutex_);
     SCOPED_LOCK(mutex); // reading 'store_.visible_docs_' and get_reader_state_unsafe(...)
     bitvector candidate_documents = used_doc_ids_; // all documents since some of them might be updates
 
@@ -1144,7 +1144,7 @@ bool store_writer::commit() {
     }
   }
 
-  async_utils::read_write_mutex::write_mutex mutex(store_.mutex_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(store_.mutex_);
   SCOPED_LOCK(mutex); // modifying 'store_.visible_docs_'
 
   if (!*reusable_) {
@@ -1250,7 +1250,7 @@ bool store_writer::index(
         return value.name_ ? hashed_bytes_ref(key.hash(), *(value.name_)) : key;
       };
 
-      async_utils::read_write_mutex::write_mutex mutex(store_.mutex_);
+      async_utils::distributed_read_write_mutex::write_mutex mutex(store_.mutex_);
       SCOPED_LOCK(mutex);
       auto field_term_itr = map_utils::try_emplace_update_key(
         field->terms_,
@@ -1429,7 +1429,7 @@ bool store_writer::store(
   // if this is the first time this column was seen for this document
   if (irs::integer_traits<size_t>::const_max == column_state_offset) {
     {
-      async_utils::read_write_mutex::write_mutex mutex(store_.mutex_);
+      async_utils::distributed_read_write_mutex::write_mutex mutex(store_.mutex_);
       SCOPED_LOCK(mutex);
       column->entries_.emplace_back(doc, out.file_pointer()); // column offset in buffer
     }
@@ -1490,7 +1490,7 @@ transaction_store::transaction_store(size_t pool_size /*= DEFAULT_POOL_SIZE*/)
 }
 
 void transaction_store::cleanup() {
-  async_utils::read_write_mutex::write_mutex mutex(mutex_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(mutex_);
   SCOPED_LOCK(mutex);
 
   used_doc_ids_ &= valid_doc_ids_; // remove invalid ids from 'used'
@@ -1585,7 +1585,7 @@ void transaction_store::cleanup() {
 }
 
 void transaction_store::clear() {
-  async_utils::read_write_mutex::write_mutex mutex(mutex_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(mutex_);
   SCOPED_LOCK(mutex);
   auto reusable = memory::make_shared<bool>(true); // create marker for next generation
 
@@ -1596,7 +1596,7 @@ void transaction_store::clear() {
 
 store_reader transaction_store::flush() {
   SCOPED_LOCK(generation_mutex_); // lock generation modification until end of flush (or in-progress writer commit with removals/updates will have an inconsistent reader)
-  async_utils::read_write_mutex::write_mutex mutex(mutex_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(mutex_);
   SCOPED_LOCK(mutex);
   auto reader = transaction_store::reader();
 
@@ -1622,7 +1622,7 @@ transaction_store::column_ref_t transaction_store::get_column(
     return value.meta_ ? hashed_string_ref(key.hash(), value.meta_->name) : key;
   };
 
-  async_utils::read_write_mutex::write_mutex mutex(mutex_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(mutex_);
   SCOPED_LOCK(mutex);
 
   auto itr = map_utils::try_emplace_update_key(
@@ -1660,7 +1660,7 @@ transaction_store::column_ref_t transaction_store::get_column(
 field_id transaction_store::get_column_id() {
   REGISTER_TIMER_DETAILED();
   field_id start = 0;
-  async_utils::read_write_mutex::write_mutex mutex(mutex_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(mutex_);
   SCOPED_LOCK(mutex);
 
   while (type_limits<type_t::field_id_t>::valid(start)) {
@@ -1687,7 +1687,7 @@ doc_id_t transaction_store::get_doc_id(doc_id_t start) {
     return type_limits<type_t::doc_id_t>::invalid();
   }
 
-  async_utils::read_write_mutex::write_mutex mutex(mutex_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(mutex_);
   SCOPED_LOCK(mutex);
 
   while (!type_limits<type_t::doc_id_t>::eof(start)) {
@@ -1722,7 +1722,7 @@ transaction_store::field_ref_t transaction_store::get_field(
     return value.meta_ ? hashed_string_ref(key.hash(), value.meta_->name) : key;
   };
 
-  async_utils::read_write_mutex::write_mutex mutex(mutex_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(mutex_);
   SCOPED_LOCK(mutex);
   auto itr = map_utils::try_emplace_update_key(
     fields_,
@@ -1780,7 +1780,7 @@ store_reader transaction_store::reader() const {
   size_t generation;
 
   {
-    async_utils::read_write_mutex::read_mutex mutex(mutex_);
+    async_utils::distributed_read_write_mutex::read_mutex mutex(mutex_);
     SCOPED_LOCK(mutex);
     documents = visible_docs_;
     generation = transaction_store::store_reader_helper::get_reader_state_unsafe(
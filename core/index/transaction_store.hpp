@@ -288,7 +288,7 @@ class IRESEARCH_API transaction_store: private util::noncopyable {
   std::unordered_map<hashed_string_ref, terms_t> fields_;
   size_t generation_; // current commit generation
   std::mutex generation_mutex_; // prevent generation modification during writer commit with removals/updates and flush (used before aquiring write lock on mutex_)
-  mutable async_utils::read_write_mutex mutex_; // mutex for 'columns_', 'fields_', 'generation_', 'visible_docs_'
+  mutable async_utils::distributed_read_write_mutex mutex_; // mutex for 'columns_', 'fields_', 'generation_', 'visible_docs_'
   reusable_t reusable_;
   bitvector used_column_ids_; // true == column id is in use by some column
 
@@ -45,27 +45,18 @@ std::pair<const irs::filter*, bool> optimize_not(const irs::Not& node) {
 }
 
 //////////////////////////////////////////////////////////////////////////////
-/// @returns disjunction iterator created from the specified queries
+/// @returns non-empty iterators of the specified queries
 //////////////////////////////////////////////////////////////////////////////
-template<typename QueryIterator, typename... Args>
-irs::doc_iterator::ptr make_disjunction(
+template<typename Iterators, typename QueryIterator>
+Iterators execute_all(
     const irs::sub_reader& rdr,
     const irs::order::prepared& ord,
     const irs::attribute_view& ctx,
     QueryIterator begin,
-    QueryIterator end,
-    Args&&... args) {
+    QueryIterator end) {
   assert(std::distance(begin, end) >= 0);
-  const size_t size = size_t(std::distance(begin, end));
-
-  // check the size before the execution
-  if (0 == size) {
-    // empty or unreachable search criteria
-    return irs::doc_iterator::empty();
-  }
-
-  irs::disjunction::doc_iterators_t itrs;
-  itrs.reserve(size);
+  Iterators itrs;
+  itrs.reserve(size_t(std::distance(begin, end)));
 
   for (;begin != end; ++begin) {
     // execute query - get doc iterator
@@ -77,8 +68,58 @@ irs::doc_iterator::ptr make_disjunction(
     }
   }
 
+  return itrs;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns true if the window based disjunction is expected to outperform
+///          the heap based one for the specified iterators
+//////////////////////////////////////////////////////////////////////////////
+template<typename Iterators>
+bool use_block_disjunction(
+    const irs::sub_reader& rdr,
+    const Iterators& itrs) {
+  if (itrs.size() < irs::block_disjunction::MIN_SIZE) {
+    return false;
+  }
+
+  irs::cost::cost_t cost = 0;
+
+  // estimate lazily, only as many iterators as needed for the decision
+  for (auto& it : itrs) {
+    if (irs::block_disjunction::worthwhile(itrs.size(), cost, rdr.docs_count())) {
+      return true;
+    }
+
+    cost += irs::cost::extract(it->attributes(), 0); // unknown cost == sparse
+  }
+
+  return irs::block_disjunction::worthwhile(
+    itrs.size(), cost, rdr.docs_count()
+  );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns disjunction iterator created from the specified queries
+//////////////////////////////////////////////////////////////////////////////
+template<typename QueryIterator, typename... Args>
+irs::doc_iterator::ptr make_disjunction(
+    const irs::sub_reader& rdr,
+    const irs::order::prepared& ord,
+    const irs::attribute_view& ctx,
+    QueryIterator begin,
+    QueryIterator end,
+    Args&&... args) {
+  // check the size before the execution
+  if (begin == end) {
+    // empty or unreachable search criteria
+    return irs::doc_iterator::empty();
+  }
+
   return irs::make_disjunction<irs::disjunction>(
-    std::move(itrs), ord, std::forward<Args>(args)...
+    execute_all<irs::disjunction::doc_iterators_t>(rdr, ord, ctx, begin, end),
+    ord,
+    std::forward<Args>(args)...
   );
 }
 
@@ -164,7 +205,7 @@ class boolean_query : public filter::prepared {
     }
 
     return doc_iterator::make<exclusion>(
-      std::move(incl), std::move(excl)
+      std::move(incl), std::move(excl), ctx.get<query_context>().get()
     );
   }
 
@@ -251,7 +292,16 @@ class or_query final : public boolean_query {
       const attribute_view& ctx,
       iterator begin,
       iterator end) const override {
-    return ::make_disjunction(rdr, ord, ctx, begin, end);
+    auto itrs = execute_all<disjunction::doc_iterators_t>(
+      rdr, ord, ctx, begin, end
+    );
+
+    if (use_block_disjunction(rdr, itrs)) {
+      // many dense clauses, heap maintenance dominates
+      return doc_iterator::make<block_disjunction>(std::move(itrs), ord);
+    }
+
+    return irs::make_disjunction<disjunction>(std::move(itrs), ord);
   }
 }; // or_query
 
@@ -291,26 +341,19 @@ class min_match_query final : public boolean_query {
     // min_match_count <= size
     min_match_count = std::min(size, min_match_count);
 
-    min_match_disjunction::doc_iterators_t itrs;
-    itrs.reserve(size);
-
-    for (;begin != end; ++begin) {
-      // execute query - get doc iterator
-      auto docs = begin->execute(rdr, ord, ctx);
-
-      // filter out empty iterators
-      if (!type_limits<type_t::doc_id_t>::eof(docs->value())) {
-        itrs.emplace_back(std::move(docs));
-      }
-    }
-
     return make_min_match_disjunction(
-      std::move(itrs), ord, min_match_count
+      rdr,
+      execute_all<min_match_disjunction::doc_iterators_t>(
+        rdr, ord, ctx, begin, end
+      ),
+      ord,
+      min_match_count
     );
   }
 
  private:
   static doc_iterator::ptr make_min_match_disjunction(
+      const sub_reader& rdr,
       min_match_disjunction::doc_iterators_t&& itrs,
       const order::prepared& ord,
       size_t min_match_count) {
@@ -335,8 +378,19 @@ class min_match_query final : public boolean_query {
       );
     }
 
-    // min match disjunction
     assert(min_match_count < size);
+
+    if (use_block_disjunction(rdr, itrs)) {
+      // many dense clauses, heap maintenance dominates
+      return doc_iterator::make<block_disjunction>(
+        block_disjunction::doc_iterators_t(
+          std::make_move_iterator(itrs.begin()),
+          std::make_move_iterator(itrs.end())
+        ), min_match_count, ord
+      );
+    }
+
+    // min match disjunction
     return doc_iterator::make<min_match_disjunction>(
       std::move(itrs), min_match_count, ord
     );
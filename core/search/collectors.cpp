@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "collectors.hpp"
+#include "cost.hpp"
+#include "score.hpp"
+#include "error/error.hpp"
+#include "utils/bytes_utils.hpp"
+#include "utils/type_limits.hpp"
+
+#include <algorithm>
+
+NS_LOCAL
+
+const irs::byte_type CURSOR_VERSION = 0;
+
+// version, segment ordinal, document id
+const size_t CURSOR_HEADER_LEN = 1 + sizeof(uint64_t) + sizeof(uint32_t);
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+int hex_value(char c) NOEXCEPT {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+
+  return -1;
+}
+
+NS_END
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                              total_hits_collector implementation
+// -----------------------------------------------------------------------------
+
+total_hits_collector::total_hits_collector(uint64_t threshold) NOEXCEPT
+  : threshold_(threshold) {
+}
+
+void total_hits_collector::collect(doc_iterator& docs) {
+  while (hits_ < threshold_ && docs.next()) {
+    ++hits_;
+    ++segment_hits_;
+  }
+
+  finish(docs);
+}
+
+void total_hits_collector::finish(const doc_iterator& docs) NOEXCEPT {
+  if (!type_limits<type_t::doc_id_t>::eof(docs.value())) {
+    // cost includes the hits counted so far, unknown cost adds nothing
+    const auto cost = cost::extract(docs.attributes(), 0);
+
+    estimated_ += cost > segment_hits_ ? cost - segment_hits_ : 0;
+    exact_ = false;
+  }
+
+  segment_hits_ = 0;
+}
+
+total_hits total_hits_collector::hits() const NOEXCEPT {
+  total_hits hits;
+
+  hits.value = hits_;
+  hits.estimate = hits_ + estimated_;
+  hits.exact = exact_;
+
+  return hits;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                top_docs_collector implementation
+// -----------------------------------------------------------------------------
+
+/*static*/ std::string top_docs_collector::to_cursor(const entry& last) {
+  bstring buf(CURSOR_HEADER_LEN + last.score.size(), 0);
+  auto* out = &buf[0];
+
+  *out++ = CURSOR_VERSION;
+  irs::write<uint64_t>(out, last.segment);
+  irs::write<uint32_t>(out, last.doc);
+  std::copy(last.score.begin(), last.score.end(), out);
+
+  std::string token;
+
+  token.reserve(2 * buf.size());
+
+  for (auto b : buf) {
+    token += HEX_DIGITS[b >> 4];
+    token += HEX_DIGITS[b & 0xF];
+  }
+
+  return token;
+}
+
+/*static*/ bool top_docs_collector::from_cursor(
+    entry& last,
+    const string_ref& token) {
+  if (token.size() % 2 || token.size() < 2 * CURSOR_HEADER_LEN) {
+    return false;
+  }
+
+  bstring buf;
+
+  buf.reserve(token.size() / 2);
+
+  for (size_t i = 0; i < token.size(); i += 2) {
+    const auto high = hex_value(token[i]);
+    const auto low = hex_value(token[i + 1]);
+
+    if (high < 0 || low < 0) {
+      return false;
+    }
+
+    buf += byte_type((high << 4) | low);
+  }
+
+  const auto* in = buf.c_str();
+
+  if (*in++ != CURSOR_VERSION) {
+    return false;
+  }
+
+  const auto segment = irs::read<uint64_t>(in);
+  const auto doc = irs::read<uint32_t>(in);
+
+  if (!type_limits<type_t::doc_id_t>::valid(doc)
+      || type_limits<type_t::doc_id_t>::eof(doc)) {
+    return false;
+  }
+
+  last.segment = size_t(segment);
+  last.doc = doc;
+  last.score.assign(in, buf.size() - CURSOR_HEADER_LEN);
+
+  return true;
+}
+
+top_docs_collector::top_docs_collector(
+    const order::prepared& order,
+    size_t size,
+    const entry* after)
+  : order_(&order),
+    size_(size),
+    has_after_(nullptr != after) {
+  if (!order.empty()) {
+    no_score_.resize(order.size());
+    order.prepare_score(&no_score_[0]);
+  }
+
+  if (after) {
+    if (after->score.size() != no_score_.size()) {
+      throw illegal_argument(); // cursor produced with a different order
+    }
+
+    after_ = *after;
+  }
+
+  heap_.reserve(size_);
+}
+
+bool top_docs_collector::ranks_before(
+    const byte_type* lhs_score, size_t lhs_segment, doc_id_t lhs_doc,
+    const byte_type* rhs_score, size_t rhs_segment, doc_id_t rhs_doc) const {
+  if (order_->less(lhs_score, rhs_score)) {
+    return true;
+  }
+
+  if (order_->less(rhs_score, lhs_score)) {
+    return false;
+  }
+
+  return lhs_segment < rhs_segment
+    || (lhs_segment == rhs_segment && lhs_doc < rhs_doc);
+}
+
+void top_docs_collector::collect(size_t segment, doc_iterator& docs) {
+  if (!size_) {
+    return;
+  }
+
+  const auto less = [this](const entry& lhs, const entry& rhs) {
+    return ranks_before(lhs, rhs);
+  };
+  const bool unordered = order_->empty();
+
+  if (unordered) {
+    // hits are ranked by segment ordinal and document id only
+    if (has_after_ && segment < after_.segment) {
+      return; // whole segment is before the cursor
+    }
+
+    if (heap_.size() == size_ && segment > heap_.front().segment) {
+      return; // whole segment is after the page
+    }
+  }
+
+  const irs::score& score = irs::score::extract(docs.attributes());
+  const bool scored = !unordered && &score != &irs::score::no_score();
+  const byte_type* value = scored ? score.c_str() : no_score_.c_str();
+  const size_t value_size = no_score_.size();
+
+  bool valid = unordered && has_after_ && segment == after_.segment
+    ? !type_limits<type_t::doc_id_t>::eof(docs.seek(after_.doc + 1))
+    : docs.next();
+
+  for (; valid; valid = docs.next()) {
+    const auto doc = docs.value();
+
+    if (scored) {
+      score.evaluate();
+    }
+
+    if (has_after_
+        && !ranks_before(after_.score.c_str(), after_.segment, after_.doc,
+                         value, segment, doc)) {
+      continue; // not after the cursor
+    }
+
+    if (heap_.size() < size_) {
+      heap_.emplace_back();
+    } else {
+      auto& worst = heap_.front();
+
+      if (!ranks_before(value, segment, doc,
+                        worst.score.c_str(), worst.segment, worst.doc)) {
+        if (unordered) {
+          break; // the rest of the segment is after the page
+        }
+
+        continue;
+      }
+
+      std::pop_heap(heap_.begin(), heap_.end(), less);
+    }
+
+    auto& hit = heap_.back();
+
+    hit.score.assign(value, value_size);
+    hit.segment = segment;
+    hit.doc = doc;
+    std::push_heap(heap_.begin(), heap_.end(), less);
+  }
+}
+
+std::vector<top_docs_collector::entry> top_docs_collector::top() const {
+  auto top = heap_;
+
+  std::sort_heap(
+    top.begin(), top.end(),
+    [this](const entry& lhs, const entry& rhs) {
+      return ranks_before(lhs, rhs);
+    }
+  );
+
+  return top;
+}
+
+std::string top_docs_collector::cursor() const {
+  return heap_.empty() ? std::string() : to_cursor(heap_.front());
+}
+
+NS_END
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
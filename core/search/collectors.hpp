@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_COLLECTORS_H
+#define IRESEARCH_COLLECTORS_H
+
+#include "sort.hpp"
+#include "index/iterators.hpp"
+#include "utils/integer.hpp"
+#include "utils/type_limits.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @struct total_hits
+/// @brief number of documents matched by a query
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API total_hits {
+  uint64_t value{}; // exact number of hits or its lower bound if !exact
+  uint64_t estimate{}; // estimated number of hits, equal to 'value' if exact
+  bool exact{true};
+}; // total_hits
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class total_hits_collector
+/// @brief counts hits of a query exactly up to a threshold, hits beyond the
+///        threshold are not iterated but estimated from the 'cost' attribute
+///        of segment iterators, e.g. for "about N results" displays
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API total_hits_collector {
+ public:
+  explicit total_hits_collector(
+    uint64_t threshold = integer_traits<uint64_t>::const_max
+  ) NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief counts a hit of the segment iterated by the caller, e.g. by a
+  ///        top-k collector, the segment must be completed via finish(...)
+  /// @return false once the threshold is reached, i.e. the caller may stop
+  ///         iterating since the rest is estimated by finish(...)
+  //////////////////////////////////////////////////////////////////////////////
+  bool collect() NOEXCEPT {
+    ++segment_hits_;
+    return ++hits_ < threshold_;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief counts hits of a segment, stops iterating 'docs' once the
+  ///        threshold is reached
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(doc_iterator& docs);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief completes the segment of 'docs', if 'docs' is not exhausted then
+  ///        its remaining hits are estimated from its 'cost' attribute
+  /// @note may be called for a segment which wasn't iterated at all
+  //////////////////////////////////////////////////////////////////////////////
+  void finish(const doc_iterator& docs) NOEXCEPT;
+
+  total_hits hits() const NOEXCEPT;
+  uint64_t threshold() const NOEXCEPT { return threshold_; }
+
+ private:
+  uint64_t threshold_;
+  uint64_t hits_{}; // counted hits of all segments
+  uint64_t segment_hits_{}; // counted hits of the current segment
+  uint64_t estimated_{}; // estimated hits not iterated
+  bool exact_{true};
+}; // total_hits_collector
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class top_docs_collector
+/// @brief collects the best 'size' hits of a query ordered by score, then by
+///        segment ordinal and document id, optionally only hits strictly
+///        after the last hit of a previous page (search-after pagination)
+/// @note a cursor is valid only for the reader snapshot and the order it was
+///       produced with since segments are identified by their ordinals
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API top_docs_collector {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @struct entry
+  /// @brief collected hit
+  //////////////////////////////////////////////////////////////////////////////
+  struct IRESEARCH_API entry {
+    bstring score; // as produced by the order, empty for an unordered query
+    size_t segment{}; // ordinal of the segment within the reader
+    doc_id_t doc{ type_limits<type_t::doc_id_t>::invalid() };
+  }; // entry
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return opaque printable token denoting the position of 'last'
+  //////////////////////////////////////////////////////////////////////////////
+  static std::string to_cursor(const entry& last);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief restores the position from a token produced by to_cursor(...)
+  /// @return false if 'token' is malformed
+  //////////////////////////////////////////////////////////////////////////////
+  static bool from_cursor(entry& last, const string_ref& token);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param after collect only hits ranked strictly after it, nullptr == none
+  /// @throws illegal_argument if the score of 'after' doesn't match 'order'
+  //////////////////////////////////////////////////////////////////////////////
+  top_docs_collector(
+    const order::prepared& order,
+    size_t size,
+    const entry* after = nullptr
+  );
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects hits of the segment with the specified ordinal, hits
+  ///        which can't make it into the page are rejected by comparing
+  ///        their scores only, an unordered query skips whole ranges of
+  ///        documents before the cursor or after the page
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(size_t segment, doc_iterator& docs);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return collected hits, best first
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<entry> top() const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return token of the last hit of the page, empty if nothing collected
+  //////////////////////////////////////////////////////////////////////////////
+  std::string cursor() const;
+
+  size_t size() const NOEXCEPT { return size_; }
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return true if hit 'lhs' ranks strictly before hit 'rhs'
+  //////////////////////////////////////////////////////////////////////////////
+  bool ranks_before(
+    const byte_type* lhs_score, size_t lhs_segment, doc_id_t lhs_doc,
+    const byte_type* rhs_score, size_t rhs_segment, doc_id_t rhs_doc
+  ) const;
+
+  bool ranks_before(const entry& lhs, const entry& rhs) const {
+    return ranks_before(
+      lhs.score.c_str(), lhs.segment, lhs.doc,
+      rhs.score.c_str(), rhs.segment, rhs.doc
+    );
+  }
+
+  const order::prepared* order_;
+  size_t size_;
+  entry after_;
+  bool has_after_;
+  bstring no_score_; // score of iterators without a 'score' attribute
+  std::vector<entry> heap_; // worst hit first
+}; // top_docs_collector
+
+NS_END
+
+#endif
@@ -78,6 +78,9 @@ struct score_iterator_adapter {
 /// t |  ...    |
 ///   V  [n] <-- end
 ///-----------------------------------------------------------------------------
+/// before seeking, a candidate document is moved past the gaps between
+/// postings blocks of the sub-iterators exposing 'block_bounds', so that
+/// blocks which can't contain a match are never decoded
 ////////////////////////////////////////////////////////////////////////////////
 class conjunction : public doc_iterator_base {
  public:
@@ -104,6 +107,14 @@ class conjunction : public doc_iterator_base {
     // estimate iterator (front's cost is already cached)
     estimate(cost::extract(front_->attributes(), cost::MAX));
 
+    // collect block bounds of sub-iterators
+    for (auto& it : itrs_) {
+      auto& bounds = it->attributes().get<block_bounds>();
+      if (bounds) {
+        bounds_.push_back(bounds.get());
+      }
+    }
+
     // copy scores into separate container
     // to avoid extra checks
     scores_.reserve(itrs_.size());
@@ -147,7 +158,7 @@ class conjunction : public doc_iterator_base {
   }
 
   virtual doc_id_t seek(doc_id_t target) override {
-    if (type_limits<type_t::doc_id_t>::eof(target = front_->seek(target))) {
+    if (type_limits<type_t::doc_id_t>::eof(target = front_->seek(align(target)))) {
       return target;
     }
 
@@ -158,9 +169,37 @@ class conjunction : public doc_iterator_base {
   // tries to converge front_ and other iterators to the specified target.
   // if it impossible tries to find first convergence place
   doc_id_t converge(doc_id_t target) {
-    for (auto rest = seek_rest(target); target != rest;) {
+    for (;;) {
+      const auto aligned = align(target);
+
+      if (target != aligned) {
+        // target can't match, move front_ without touching the rest
+        target = front_->seek(aligned);
+        continue;
+      }
+
+      const auto rest = seek_rest(target);
+
+      if (target == rest) {
+        return target;
+      }
+
       target = front_->seek(rest);
-      rest = seek_rest(target);
+    }
+  }
+
+  // returns the least document not less than the specified target
+  // which may be present in all iterators according to their block bounds
+  doc_id_t align(doc_id_t target) {
+    for (auto begin = bounds_.begin(), it = begin, end = bounds_.end(); it != end;) {
+      const auto doc = (*it)->shallow_seek(target);
+
+      if (target < doc) {
+        target = doc;
+        it = begin; // recheck iterators with the new target
+      } else {
+        ++it;
+      }
     }
 
     return target;
@@ -185,6 +224,7 @@ class conjunction : public doc_iterator_base {
   }
 
   doc_iterators_t itrs_;
+  std::vector<block_bounds*> bounds_; // block bounds of sub-iterators
   std::vector<const irs::score*> scores_; // valid sub-scores
   irs::doc_iterator* front_;
 }; // conjunction
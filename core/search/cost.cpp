@@ -26,6 +26,6 @@
 
 NS_ROOT
 
-DEFINE_ATTRIBUTE_TYPE(iresearch::cost);
+DEFINE_ATTRIBUTE_TYPE_SLOT(iresearch::cost, COST);
 
 NS_END // ROOT
@@ -25,10 +25,13 @@
 #define IRESEARCH_DISJUNCTION_H
 
 #include "conjunction.hpp"
+#include "utils/math_utils.hpp"
 #include "utils/std.hpp"
 #include "utils/type_limits.hpp"
 #include "index/iterators.hpp"
 
+#include <cstddef>
+#include <cstring>
 #include <queue>
 
 NS_ROOT
@@ -370,6 +373,284 @@ class small_disjunction : public doc_iterator_base {
   doc_id_t doc_;
 }; // small_disjunction
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class block_disjunction
+/// @brief window based disjunction, sub-iterators are drained window by window
+///        of WINDOW documents, accumulating a bitmap of accepted documents,
+///        number of matched sub-iterators and score of every document of the
+///        window, so there is no per-document heap maintenance, a document is
+///        accepted if it is matched by at least 'min_match_count' sub-iterators
+/// @note scores are accumulated eagerly while filling a window, every refill
+///       visits all sub-iterators, hence it pays off for a bounded number of
+///       dense clauses only, @see worthwhile(...), seek(...) past the current
+///       window fills a SEEK_WINDOW only since the following documents are
+///       likely to be skipped by a driving conjunction
+////////////////////////////////////////////////////////////////////////////////
+class block_disjunction : public doc_iterator_base {
+ public:
+  typedef score_iterator_adapter doc_iterator_t;
+  typedef std::vector<doc_iterator_t> doc_iterators_t;
+
+  static const size_t WINDOW = 2048; // number of documents in a window
+  static const size_t SEEK_WINDOW = 64; // number of documents filled by seek
+  static const size_t MIN_SIZE = 8; // min number of sub-iterators to use it
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns true if block_disjunction is expected to outperform the heap
+  ///          based disjunctions for 'size' sub-iterators matching 'cost'
+  ///          documents in total within a segment of 'docs_count' documents,
+  ///          i.e. if a window is expected to hold at least one document per
+  ///          sub-iterator
+  //////////////////////////////////////////////////////////////////////////////
+  static bool worthwhile(
+      size_t size,
+      cost::cost_t cost,
+      uint64_t docs_count) NOEXCEPT {
+    return size >= MIN_SIZE
+      && double(cost) * WINDOW >= double(size) * double(docs_count);
+  }
+
+  block_disjunction(
+      doc_iterators_t&& itrs,
+      const order::prepared& ord,
+      cost::cost_t est)
+    : block_disjunction(std::move(itrs), 1, ord, resolve_overload_tag()) {
+    // estimate disjunction
+    estimate(est);
+  }
+
+  explicit block_disjunction(
+      doc_iterators_t&& itrs,
+      const order::prepared& ord = order::prepared::unordered())
+    : block_disjunction(std::move(itrs), 1, ord) {
+  }
+
+  block_disjunction(
+      doc_iterators_t&& itrs,
+      size_t min_match_count,
+      const order::prepared& ord = order::prepared::unordered())
+    : block_disjunction(std::move(itrs), min_match_count, ord, resolve_overload_tag()) {
+    // estimate disjunction
+    estimate([this](){
+      return std::accumulate(
+        itrs_.begin(), itrs_.end(), cost::cost_t(0),
+        [](cost::cost_t lhs, const doc_iterator_t& rhs) {
+          return lhs + cost::extract(rhs->attributes(), 0);
+      });
+    });
+  }
+
+  virtual doc_id_t value() const NOEXCEPT override {
+    return doc_;
+  }
+
+  virtual bool next() override {
+    if (type_limits<type_t::doc_id_t>::eof(doc_)) {
+      return false;
+    }
+
+    return !type_limits<type_t::doc_id_t>::eof(advance(doc_ + 1, WINDOW));
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    if (type_limits<type_t::doc_id_t>::eof(doc_) || target <= doc_) {
+      return doc_;
+    }
+
+    return advance(target, SEEK_WINDOW);
+  }
+
+ private:
+  struct resolve_overload_tag{};
+
+  static const size_t WORDS = WINDOW / 64; // words in the window bitmap
+
+  block_disjunction(
+      doc_iterators_t&& itrs,
+      size_t min_match_count,
+      const order::prepared& ord,
+      resolve_overload_tag)
+    : doc_iterator_base(ord),
+      itrs_(std::move(itrs)),
+      min_match_count_((std::max)(size_t(1), min_match_count)),
+      doc_(itrs_.empty()
+        ? type_limits<type_t::doc_id_t>::eof()
+        : type_limits<type_t::doc_id_t>::invalid()) {
+    if (min_match_count_ > 1) {
+      counts_.resize(WINDOW); // the bitmap is enough to track single matches
+    }
+
+    if (!ord_->empty()) {
+      for (auto& it : itrs_) {
+        if (&irs::score::no_score() != it.score) {
+          // keep scores of a window aligned as individual scores are
+          const auto align = alignof(std::max_align_t);
+          score_stride_ = (ord_->size() + align - 1) & ~(align - 1);
+          scores_.resize(WINDOW * score_stride_);
+          break;
+        }
+      }
+    }
+
+    // prepare score
+    if (scores_.empty()) {
+      prepare_score([this](byte_type* score) {
+        ord_->prepare_score(score);
+      });
+    } else {
+      prepare_score([this](byte_type* score) {
+        assert(doc_ >= base_ && doc_ < end_);
+        std::memcpy(
+          score, &scores_[(doc_ - base_) * score_stride_], ord_->size()
+        );
+      });
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief positions iterator at the first accepted document >= target
+  /// @param window number of documents to fill if target is past the current
+  ///        window, the following windows are filled completely
+  //////////////////////////////////////////////////////////////////////////////
+  doc_id_t advance(doc_id_t target, size_t window) {
+    for (;;) {
+      if (target >= base_ && target < end_ && scan(target - base_)) {
+        return doc_;
+      }
+
+      // sub-iterators are already positioned past the current window
+      if (!refill((std::max)(target, end_), window)) {
+        return doc_ = type_limits<type_t::doc_id_t>::eof();
+      }
+
+      target = base_;
+      window = WINDOW;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fills 'window' documents starting at the least document >= target
+  /// @returns false if there are no more documents to accept
+  //////////////////////////////////////////////////////////////////////////////
+  bool refill(doc_id_t target, size_t window) {
+    doc_id_t min = type_limits<type_t::doc_id_t>::eof();
+
+    for (auto begin = itrs_.begin(); begin != itrs_.end(); ) {
+      auto& it = *begin;
+      auto doc = it->value();
+
+      if (doc < target) {
+        doc = it->seek(target);
+      }
+
+      if (type_limits<type_t::doc_id_t>::eof(doc)) {
+        std::swap(it, itrs_.back());
+        itrs_.pop_back();
+        continue; // don't need to increment 'begin' here
+      }
+
+      min = (std::min)(min, doc);
+      ++begin;
+    }
+
+    if (itrs_.size() < min_match_count_) {
+      return false; // exhausted
+    }
+
+    assert(window <= WINDOW);
+    base_ = min;
+    end_ = doc_id_t((std::min)(
+      uint64_t(base_) + window,
+      uint64_t(type_limits<type_t::doc_id_t>::eof())
+    ));
+
+    std::memset(mask_, 0, sizeof mask_);
+
+    if (!counts_.empty()) {
+      // only the counters touched by the previous window
+      std::fill(counts_.begin(), counts_.begin() + counts_used_, 0);
+      counts_used_ = 0;
+    }
+
+    for (auto& it : itrs_) {
+      for (auto doc = it->value(); doc < end_; it->next(), doc = it->value()) {
+        const size_t i = doc - base_;
+        auto& word = mask_[i / 64];
+        const auto bit = uint64_t(1) << (i % 64);
+
+        if (counts_.empty()) {
+          // single match is enough
+          if (!scores_.empty()) {
+            auto* score = &scores_[i * score_stride_];
+
+            if (!(word & bit)) {
+              ord_->prepare_score(score);
+            }
+
+            detail::score_add(score, *ord_, it);
+          }
+
+          word |= bit;
+          continue;
+        }
+
+        auto& count = counts_[i];
+
+        if (!scores_.empty()) {
+          auto* score = &scores_[i * score_stride_];
+
+          if (!count) {
+            ord_->prepare_score(score);
+          }
+
+          detail::score_add(score, *ord_, it);
+        }
+
+        if (++count == min_match_count_) {
+          word |= bit;
+        }
+
+        counts_used_ = (std::max)(counts_used_, i + 1);
+      }
+    }
+
+    return true;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief finds the first accepted document of the window at or after the
+  ///        specified offset within the window
+  //////////////////////////////////////////////////////////////////////////////
+  bool scan(size_t i) NOEXCEPT {
+    auto word = i / 64;
+    auto bits = mask_[word] & (~uint64_t(0) << (i % 64));
+
+    for (;;) {
+      if (bits) {
+        doc_ = base_ + doc_id_t(word * 64 + math::math_traits<uint64_t>::ctz(bits));
+        return true;
+      }
+
+      if (++word == WORDS) {
+        return false;
+      }
+
+      bits = mask_[word];
+    }
+  }
+
+  doc_iterators_t itrs_;
+  std::vector<uint32_t> counts_; // number of matched sub-iterators by document, empty if min_match_count == 1
+  size_t counts_used_{}; // number of leading 'counts_' touched by the window
+  std::vector<byte_type> scores_; // accumulated scores by document
+  uint64_t mask_[WORDS]; // accepted documents of the window
+  size_t min_match_count_;
+  size_t score_stride_{}; // distance between scores of adjacent documents
+  doc_id_t base_{}; // first document of the window
+  doc_id_t end_{}; // end of the window
+  doc_id_t doc_;
+}; // block_disjunction
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @class disjunction
 /// @brief heap sort based disjunction
@@ -25,6 +25,7 @@
 #define IRESEARCH_EXCLUSION_H
 
 #include "index/iterators.hpp"
+#include "query_context.hpp"
 
 NS_ROOT
 
@@ -33,8 +34,15 @@ NS_ROOT
 ////////////////////////////////////////////////////////////////////////////////
 class exclusion final : public doc_iterator {
  public:
-  exclusion(doc_iterator::ptr&& incl, doc_iterator::ptr&& excl) NOEXCEPT
-    : incl_(std::move(incl)), excl_(std::move(excl)) {
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param ctx budget of the query, exclusion ends once it is exhausted since
+  ///        truncated 'excl' can't prove a document isn't excluded
+  //////////////////////////////////////////////////////////////////////////////
+  exclusion(
+      doc_iterator::ptr&& incl,
+      doc_iterator::ptr&& excl,
+      const query_context* ctx = nullptr) NOEXCEPT
+    : incl_(std::move(incl)), excl_(std::move(excl)), ctx_(ctx) {
     assert(incl_);
     assert(excl_);
   }
@@ -89,11 +97,17 @@ class exclusion final : public doc_iterator {
       }
     }
 
+    if (ctx_ && ctx_->incomplete()) {
+      // budget exhausted, 'excl' may have ended before 'target'
+      return incl_->seek(type_limits<type_t::doc_id_t>::eof());
+    }
+
     return target;
   }
 
   doc_iterator::ptr incl_;
   doc_iterator::ptr excl_;
+  const query_context* ctx_;
 }; // exclusion
 
 NS_END // ROOT
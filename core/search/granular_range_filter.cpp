@@ -73,6 +73,52 @@ iresearch::bytes_ref mask_value(
     : iresearch::bytes_ref();
 }
 
+// returns the term of the specified bound on the same granularity level as
+// the specified term of a field, nullptr if there is no such term
+const iresearch::bstring* find_granularity(
+  const iresearch::by_granular_range::terms_t& bound,
+  const iresearch::bytes_ref& term,
+  size_t prefix_size
+) {
+  if (term.null()) {
+    return nullptr; // reader does not track min/max terms
+  }
+
+  const auto level = mask_granularity(term, prefix_size);
+
+  for (auto& entry: bound) {
+    if (mask_granularity(entry.second, prefix_size) == level) {
+      return &entry.second;
+    }
+  }
+
+  return nullptr;
+}
+
+// returns false if the field has no terms within the range for sure,
+// the least term of a field belongs to its most granular level and the
+// greatest term to its least granular level, so field bounds are comparable
+// only with the terms of the range on the same granularity levels
+bool overlaps(
+  const iresearch::term_reader& field,
+  size_t prefix_size,
+  const iresearch::by_granular_range::terms_t& min_term,
+  bool min_term_inclusive,
+  const iresearch::by_granular_range::terms_t& max_term,
+  bool max_term_inclusive
+) {
+  auto* min = find_granularity(min_term, (field.max)(), prefix_size);
+  auto* max = find_granularity(max_term, (field.min)(), prefix_size);
+
+  // a less granular term of a range bound covers the exact one
+  return field.overlaps(
+    min ? iresearch::bytes_ref(*min) : iresearch::bytes_ref::NIL,
+    !min || min != &(min_term.begin()->second) || min_term_inclusive,
+    max ? iresearch::bytes_ref(*max) : iresearch::bytes_ref::NIL,
+    !max || max != &(max_term.begin()->second) || max_term_inclusive
+  );
+}
+
 // collect terms while they are accepted by Comparer
 template<typename Comparer>
 iresearch::range_state& collect_terms(
@@ -558,6 +604,11 @@ filter::prepared::ptr by_granular_range::prepare(
     }
 
     size_t prefix_size = tr->meta().features.check<granularity_prefix>() ? 1 : 0;
+
+    if (!overlaps(*tr, prefix_size, rng_.min, Bound_Type::INCLUSIVE == rng_.min_type, rng_.max, Bound_Type::INCLUSIVE == rng_.max_type)) {
+      continue; // segment can't contain terms within the range
+    }
+
     seek_term_iterator::ptr terms = tr->iterator();
 
     if (!terms->next()) {
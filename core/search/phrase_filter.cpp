@@ -26,6 +26,7 @@
 #include "cost.hpp"
 #include "term_query.hpp"
 #include "conjunction.hpp"
+#include "query_context.hpp"
 
 #if defined(_MSC_VER)
   #pragma warning( disable : 4706 )
@@ -99,7 +100,7 @@ class phrase_query : public filter::prepared {
   virtual doc_iterator::ptr execute(
       const sub_reader& rdr,
       const order::prepared& ord,
-      const attribute_view& /*ctx*/) const override {
+      const attribute_view& ctx) const override {
     // get phrase state for the specified reader
     auto phrase_state = states_.find(rdr);
     if (!phrase_state) {
@@ -137,14 +138,16 @@ class phrase_query : public filter::prepared {
       }
       positions.emplace_back(std::ref(*pos), term_stats->second);
 
-      // add base iterator
+      // add base iterator, every term is checked against the budget since
+      // the phrase iterator may scan many documents without a match
       itrs.emplace_back(doc_iterator::make<basic_doc_iterator>(
         rdr,
         *phrase_state->reader,
-        term_stats->first, 
-        std::move(docs), 
-        ord, 
-        term_state.second
+        term_stats->first,
+        std::move(docs),
+        ord,
+        term_state.second,
+        ctx.get<query_context>().get()
       ));
 
       ++term_stats;
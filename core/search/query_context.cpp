@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "query_context.hpp"
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                     query_context implementation
+// -----------------------------------------------------------------------------
+
+REGISTER_ATTRIBUTE(iresearch::query_context);
+DEFINE_ATTRIBUTE_TYPE(query_context);
+
+query_context::query_context() NOEXCEPT
+  : cancelled_(false),
+    deadline_(clock_t::time_point::max()),
+    countdown_(1), // evaluate the budget at the first check
+    incomplete_(false) {
+}
+
+query_context::query_context(clock_t::duration budget) NOEXCEPT
+  : query_context() {
+  deadline_ = clock_t::now() + budget;
+}
+
+bool query_context::check_budget() NOEXCEPT {
+  countdown_ = CHECK_INTERVAL;
+  incomplete_ = cancelled_.load()
+    || (deadline_ != clock_t::time_point::max() && clock_t::now() >= deadline_);
+
+  return !incomplete_;
+}
+
+NS_END
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
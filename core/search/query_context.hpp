@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_QUERY_CONTEXT_H
+#define IRESEARCH_QUERY_CONTEXT_H
+
+#include "index/iterators.hpp"
+#include "utils/attributes.hpp"
+
+#include <atomic>
+#include <chrono>
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class query_context
+/// @brief execution budget of a query, i.e. a deadline and a cancellation flag,
+///        passed to filter::prepared::execute(...) via the context attributes,
+///        leaf iterators stop producing documents once the budget is exhausted
+///        so that the documents collected so far form a partial result
+/// @note leaf iterators check the context once per CHECK_WINDOW document ids
+///       they pass, the deadline and the flag are evaluated once per
+///       CHECK_INTERVAL checks of all leaf iterators of a query, i.e. a
+///       context is meant to be used by a single query thread, only cancel()
+///       may be called from other threads
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API query_context : public attribute {
+ public:
+  typedef std::chrono::steady_clock clock_t;
+
+  static const doc_id_t CHECK_WINDOW = 128; // a block of postings
+  static const size_t CHECK_INTERVAL = 16; // arbitrary value
+
+  DECLARE_ATTRIBUTE_TYPE();
+
+  query_context() NOEXCEPT;
+  explicit query_context(clock_t::duration budget) NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief request the query to stop at the next check
+  //////////////////////////////////////////////////////////////////////////////
+  void cancel() NOEXCEPT { cancelled_.store(true); }
+
+  clock_t::time_point deadline() const NOEXCEPT { return deadline_; }
+  void deadline(clock_t::time_point value) NOEXCEPT { deadline_ = value; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return true if query execution may continue, the first and then every
+  ///         CHECK_INTERVAL call evaluates the deadline and the cancellation
+  ///         flag
+  //////////////////////////////////////////////////////////////////////////////
+  bool check() NOEXCEPT {
+    if (incomplete_) {
+      return false;
+    }
+
+    return --countdown_ ? true : check_budget();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return the query was stopped before all documents were evaluated,
+  ///         i.e. results are partial
+  //////////////////////////////////////////////////////////////////////////////
+  bool incomplete() const NOEXCEPT { return incomplete_; }
+
+ private:
+  bool check_budget() NOEXCEPT;
+
+  std::atomic<bool> cancelled_;
+  clock_t::time_point deadline_;
+  size_t countdown_; // calls left until the next budget evaluation
+  bool incomplete_;
+}; // query_context
+
+NS_END
+
+#endif
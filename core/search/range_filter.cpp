@@ -140,6 +140,15 @@ filter::prepared::ptr by_range::prepare(
       continue;
     }
 
+    if (!field->overlaps(
+          Bound_Type::UNBOUNDED == rng_.min_type ? bytes_ref::NIL : bytes_ref(rng_.min),
+          Bound_Type::INCLUSIVE == rng_.min_type,
+          Bound_Type::UNBOUNDED == rng_.max_type ? bytes_ref::NIL : bytes_ref(rng_.max),
+          Bound_Type::INCLUSIVE == rng_.max_type)) {
+      // segment can't contain terms within the range
+      continue;
+    }
+
     auto terms = field->iterator();
     bool res = false;
 
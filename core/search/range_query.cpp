@@ -25,6 +25,7 @@
 #include "shared.hpp"
 #include "range_query.hpp"
 #include "disjunction.hpp"
+#include "query_context.hpp"
 #include "score_doc_iterators.hpp"
 #include "index/index_reader.hpp"
 #include "utils/hash_utils.hpp"
@@ -161,7 +162,7 @@ range_query::range_query(states_t&& states)
 doc_iterator::ptr range_query::execute(
     const sub_reader& rdr,
     const order::prepared& ord,
-    const attribute_view& /*ctx*/) const {
+    const attribute_view& ctx) const {
   // get term state for the specified reader
   auto state = states_.find(rdr);
   if (!state) {
@@ -184,9 +185,11 @@ doc_iterator::ptr range_query::execute(
 
   // get required features for order
   auto& features = ord.features();
+  auto& query_ctx = ctx.get<query_context>();
 
-  // add an iterator for the unscored docs
-  if (has_bit_set) {
+  // add an iterator for the unscored docs, they are already evaluated at
+  // prepare time so the budget is checked once for all of them
+  if (has_bit_set && (!query_ctx || query_ctx->check())) {
     itrs.emplace_back(doc_iterator::make<bitset_doc_iterator>(
       state->unscored_docs
     ));
@@ -200,6 +203,10 @@ doc_iterator::ptr range_query::execute(
     auto& stats = entry.second;
     assert(offset >= last_offset);
 
+    if (query_ctx && !query_ctx->check()) {
+      break; // budget exhausted while opening postings, partial result
+    }
+
     if (!skip(*terms, offset - last_offset)) {
       continue; // reached end of iterator
     }
@@ -211,7 +218,8 @@ doc_iterator::ptr range_query::execute(
       stats,
       terms->postings(features),
       ord,
-      state->estimation
+      state->estimation,
+      query_ctx.get()
     ));
   }
 
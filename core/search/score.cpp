@@ -36,7 +36,7 @@ NS_ROOT
 // --SECTION--                                                            score
 // ----------------------------------------------------------------------------
 
-DEFINE_ATTRIBUTE_TYPE(iresearch::score);
+DEFINE_ATTRIBUTE_TYPE_SLOT(iresearch::score, SCORE);
 
 /*static*/ const irs::score& score::no_score() NOEXCEPT {
   return EMPTY_SCORE;
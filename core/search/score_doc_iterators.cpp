@@ -23,6 +23,7 @@
 
 #include "shared.hpp"
 #include "score_doc_iterators.hpp"
+#include "query_context.hpp"
 
 NS_ROOT
 
@@ -43,15 +44,26 @@ basic_doc_iterator::basic_doc_iterator(
     const attribute_store& stats,
     doc_iterator::ptr&& it,
     const order::prepared& ord,
-    cost::cost_t estimation) NOEXCEPT
+    cost::cost_t estimation,
+    query_context* ctx) NOEXCEPT
   : doc_iterator_base(ord),
     it_(std::move(it)), 
-    stats_(&stats) {
+    stats_(&stats),
+    ctx_(ctx),
+    window_end_(ctx
+      ? type_limits<type_t::doc_id_t>::invalid() // check at the first document
+      : type_limits<type_t::doc_id_t>::eof()) {
   assert(it_);
 
   // set estimation value
   estimate(estimation);
 
+  // expose block bounds of the underlying postings, if any
+  auto& bounds = it_->attributes().get<block_bounds>();
+  if (bounds) {
+    attrs_.emplace(*bounds);
+  }
+
   // set scorers
   scorers_ = ord_->prepare_scorers(
     segment, field, *stats_, it_->attributes()
@@ -62,6 +74,31 @@ basic_doc_iterator::basic_doc_iterator(
   });
 }
 
+bool basic_doc_iterator::next_window() {
+  typedef type_limits<type_t::doc_id_t> limits;
+
+  const auto doc = it_->value();
+
+  if (limits::eof(doc)) {
+    return true; // reached the end, nothing to check
+  }
+
+  assert(ctx_);
+
+  if (!ctx_->check()) {
+    window_end_ = limits::eof();
+    it_->seek(limits::eof()); // budget exhausted, partial result
+
+    return false;
+  }
+
+  window_end_ = doc < limits::eof() - query_context::CHECK_WINDOW
+    ? doc + query_context::CHECK_WINDOW
+    : limits::eof();
+
+  return true;
+}
+
 #if defined(_MSC_VER)
   #pragma warning( default : 4706 )
 #elif defined (__GNUC__)
@@ -28,9 +28,12 @@
 #include "analysis/token_attributes.hpp"
 #include "score.hpp"
 #include "cost.hpp"
+#include "utils/type_limits.hpp"
 
 NS_ROOT
 
+class query_context;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @class doc_iterator_base
 ////////////////////////////////////////////////////////////////////////////////
@@ -71,30 +74,43 @@ class IRESEARCH_API doc_iterator_base : public doc_iterator {
 ////////////////////////////////////////////////////////////////////////////////
 class basic_doc_iterator final : public doc_iterator_base {
  public:
+   //////////////////////////////////////////////////////////////////////////////
+   /// @param ctx budget checked once per query_context::CHECK_WINDOW document
+   ///        ids passed, nullptr == unlimited
+   //////////////////////////////////////////////////////////////////////////////
    basic_doc_iterator(
      const sub_reader& segment,
      const term_reader& field,
      const attribute_store& stats,
      doc_iterator::ptr&& it,
      const order::prepared& ord,
-     cost::cost_t estimation) NOEXCEPT;
+     cost::cost_t estimation,
+     query_context* ctx = nullptr) NOEXCEPT;
 
   virtual doc_id_t value() const override {
     return it_->value();
   }
 
   virtual bool next() override {
-    return it_->next();
+    return it_->next() && (it_->value() < window_end_ || next_window());
   }
 
   virtual doc_id_t seek(doc_id_t target) override {
-    return it_->seek(target);
+    target = it_->seek(target);
+
+    return target < window_end_ || next_window() ? target : it_->value();
   }
 
  private:
+  // checks the budget once the current window is passed, moves the
+  // underlying iterator to eof if the budget is exhausted
+  bool next_window();
+
   order::prepared::scorers scorers_;
   doc_iterator::ptr it_;
   const attribute_store* stats_;
+  query_context* ctx_;
+  doc_id_t window_end_; // eof() if no budget
 }; // basic_doc_iterator
 
 NS_END // ROOT
@@ -23,6 +23,7 @@
 
 #include "shared.hpp"
 #include "term_query.hpp"
+#include "query_context.hpp"
 #include "score_doc_iterators.hpp"
 
 #include "index/index_reader.hpp"
@@ -53,6 +54,10 @@ term_query::ptr term_query::make(
       continue;
     }
 
+    if (!reader->overlaps(term, true, term, true)) {
+      continue; // term is out of field bounds, don't touch term dictionary
+    }
+
     // find term
     auto terms = reader->iterator();
 
@@ -98,7 +103,7 @@ term_query::term_query(term_query::states_t&& states, attribute_store&& attrs)
 doc_iterator::ptr term_query::execute(
     const sub_reader& rdr,
     const order::prepared& ord,
-    const attribute_view& /*ctx*/) const {
+    const attribute_view& ctx) const {
   // get term state for the specified reader
   auto state = states_.find(rdr);
   if (!state) {
@@ -117,12 +122,13 @@ doc_iterator::ptr term_query::execute(
 
   // return iterator
   return doc_iterator::make<basic_doc_iterator>(
-    rdr, 
+    rdr,
     *state->reader,
-    this->attributes(), 
-    terms->postings(ord.features()), 
-    ord, 
-    state->estimation
+    this->attributes(),
+    terms->postings(ord.features()),
+    ord,
+    state->estimation,
+    ctx.get<query_context>().get()
   );
 }
 
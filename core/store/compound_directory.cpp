@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "compound_directory.hpp"
+#include "store_utils.hpp"
+#include "formats/format_utils.hpp"
+#include "error/error.hpp"
+#include "utils/bytes_utils.hpp"
+#include "utils/log.hpp"
+#include "utils/memory.hpp"
+
+NS_LOCAL
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class range_index_input
+/// @brief input over the range [offset, offset + length) of another input
+////////////////////////////////////////////////////////////////////////////////
+class range_index_input final : public irs::index_input {
+ public:
+  range_index_input(
+      irs::index_input::ptr&& in,
+      size_t offset,
+      size_t length
+  ) NOEXCEPT
+    : in_(std::move(in)),
+      offset_(offset),
+      length_(length) {
+    assert(in_);
+  }
+
+  virtual ptr dup() const NOEXCEPT override {
+    return wrap(in_->dup());
+  }
+
+  virtual ptr reopen() const NOEXCEPT override {
+    return wrap(in_->reopen());
+  }
+
+  virtual irs::byte_type read_byte() override {
+    ensure(sizeof(irs::byte_type));
+    return in_->read_byte();
+  }
+
+  virtual size_t read_bytes(irs::byte_type* b, size_t count) override {
+    return in_->read_bytes(b, (std::min)(count, remain()));
+  }
+
+  virtual int32_t read_int() override {
+    ensure(sizeof(uint32_t));
+    return in_->read_int();
+  }
+
+  virtual int64_t read_long() override {
+    ensure(sizeof(uint64_t));
+    return in_->read_long();
+  }
+
+  virtual uint32_t read_vint() override {
+    // read byte by byte near the end of the range
+    return remain() < irs::bytes_io<uint32_t>::const_max_vsize
+      ? irs::index_input::read_vint()
+      : in_->read_vint();
+  }
+
+  virtual uint64_t read_vlong() override {
+    // read byte by byte near the end of the range
+    return remain() < irs::bytes_io<uint64_t>::const_max_vsize
+      ? irs::index_input::read_vlong()
+      : in_->read_vlong();
+  }
+
+  virtual size_t file_pointer() const override {
+    return in_->file_pointer() - offset_;
+  }
+
+  virtual size_t length() const override {
+    return length_;
+  }
+
+  virtual bool eof() const override {
+    return file_pointer() >= length_;
+  }
+
+  virtual void seek(size_t pos) override {
+    in_->seek(offset_ + pos);
+  }
+
+  virtual int64_t checksum(size_t offset) const override {
+    return in_->checksum((std::min)(offset, remain()));
+  }
+
+ private:
+  // throws eof_error unless 'size' bytes remain in the range
+  void ensure(size_t size) const {
+    if (remain() < size) {
+      throw irs::eof_error(); // read past the end of the range
+    }
+  }
+
+  size_t remain() const {
+    const auto pos = file_pointer();
+    return pos < length_ ? length_ - pos : 0;
+  }
+
+  ptr wrap(irs::index_input::ptr&& in) const NOEXCEPT {
+    if (!in) {
+      return nullptr;
+    }
+
+    try {
+      return irs::memory::make_unique<range_index_input>(
+        std::move(in), offset_, length_
+      );
+    } catch (...) {
+      IR_LOG_EXCEPTION();
+    }
+
+    return nullptr;
+  }
+
+  irs::index_input::ptr in_;
+  const size_t offset_;
+  const size_t length_;
+}; // range_index_input
+
+NS_END
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                 compound_directory implementation
+// -----------------------------------------------------------------------------
+
+MSVC2015_ONLY(__pragma(warning(push)))
+MSVC2015_ONLY(__pragma(warning(disable: 4592))) // symbol will be dynamically initialized (implementation limitation) false positive bug in VS2015.1
+const string_ref compound_directory::FORMAT_EXT = "cf";
+const string_ref compound_directory::FORMAT_NAME = "iresearch_compound_file";
+MSVC2015_ONLY(__pragma(warning(pop)))
+
+/*static*/ std::string compound_directory::file_name(const string_ref& segment) {
+  std::string name;
+
+  name.reserve(segment.size() + 1 + FORMAT_EXT.size());
+  name.append(segment.c_str(), segment.size());
+  name += '.';
+  name.append(FORMAT_EXT.c_str(), FORMAT_EXT.size());
+
+  return name;
+}
+
+/*static*/ compound_directory::ptr compound_directory::open(
+    const directory& dir,
+    const std::string& segment) {
+  auto in = dir.open(file_name(segment), IOAdvice::RANDOM);
+
+  if (!in) {
+    IR_FRMT_ERROR(
+      "Failed to open compound file of segment '%s'", segment.c_str()
+    );
+
+    return nullptr;
+  }
+
+  format_utils::check_header(*in, FORMAT_NAME, FORMAT_MIN, FORMAT_MAX);
+  format_utils::read_checksum(*in); // validates footer
+
+  in->seek(in->length() - format_utils::FOOTER_LEN - sizeof(uint64_t));
+  in->seek(in->read_long()); // table of contained files
+
+  entries_t entries;
+
+  for (auto count = in->read_vlong(); count; --count) {
+    auto name = read_string<std::string>(*in);
+    entry value;
+
+    value.offset = in->read_vlong();
+    value.length = in->read_vlong();
+
+    if (value.offset + value.length > in->length()) {
+      throw index_error(string_utils::to_string(
+        "while opening compound file of segment '%s', error: invalid range of file '%s'",
+        segment.c_str(), name.c_str()
+      ));
+    }
+
+    entries.emplace(std::move(name), value);
+  }
+
+  PTR_NAMED(
+    compound_directory,
+    view,
+    dir,
+    segment,
+    std::move(in),
+    std::move(entries)
+  );
+
+  return view;
+}
+
+/*static*/ bool compound_directory::write(
+    directory& dir,
+    const std::string& segment,
+    const std::vector<std::string>& files) {
+  const auto filename = file_name(segment);
+  auto out = dir.create(filename);
+
+  if (!out) {
+    IR_FRMT_ERROR("Failed to create compound file '%s'", filename.c_str());
+
+    return false;
+  }
+
+  format_utils::write_header(*out, FORMAT_NAME, FORMAT_MAX);
+
+  std::vector<std::pair<string_ref, entry>> entries;
+  byte_type buf[65536]; // arbitrary size
+
+  entries.reserve(files.size());
+
+  for (auto& file : files) {
+    if (!starts_with(file, string_ref(segment))) {
+      IR_FRMT_ERROR(
+        "File '%s' does not belong to segment '%s'",
+        file.c_str(), segment.c_str()
+      );
+
+      return false;
+    }
+
+    auto in = dir.open(file, IOAdvice::READONCE_SEQUENTIAL);
+
+    if (!in) {
+      IR_FRMT_ERROR("Failed to open file '%s'", file.c_str());
+
+      return false;
+    }
+
+    entry value;
+    value.offset = out->file_pointer();
+    value.length = in->length();
+
+    for (auto left = in->length(); left;) {
+      const auto read = in->read_bytes(buf, (std::min)(left, sizeof buf));
+
+      if (!read) {
+        IR_FRMT_ERROR("Failed to read file '%s'", file.c_str());
+
+        return false;
+      }
+
+      out->write_bytes(buf, read);
+      left -= read;
+    }
+
+    entries.emplace_back(
+      string_ref(file.c_str() + segment.size(), file.size() - segment.size()),
+      value
+    );
+  }
+
+  const uint64_t table_offset = out->file_pointer();
+
+  out->write_vlong(entries.size());
+
+  for (auto& entry : entries) {
+    write_string(*out, entry.first);
+    out->write_vlong(entry.second.offset);
+    out->write_vlong(entry.second.length);
+  }
+
+  out->write_long(table_offset);
+  format_utils::write_footer(*out);
+
+  return true;
+}
+
+compound_directory::compound_directory(
+    const directory& dir,
+    const std::string& segment,
+    index_input::ptr&& in,
+    entries_t&& entries) NOEXCEPT
+  : dir_(dir),
+    entries_(std::move(entries)),
+    in_(std::move(in)),
+    segment_(segment) {
+}
+
+const compound_directory::entry* compound_directory::find(
+    const std::string& name) const NOEXCEPT {
+  if (!starts_with(name, string_ref(segment_))) {
+    return nullptr;
+  }
+
+  try {
+    const auto it = entries_.find(name.substr(segment_.size()));
+
+    return it == entries_.end() ? nullptr : &it->second;
+  } catch (...) {
+    IR_LOG_EXCEPTION();
+  }
+
+  return nullptr;
+}
+
+attribute_store& compound_directory::attributes() NOEXCEPT {
+  return const_cast<directory&>(dir_).attributes();
+}
+
+void compound_directory::close() NOEXCEPT {
+  // NOOP, read-only view
+}
+
+index_output::ptr compound_directory::create(
+    const std::string& /*name*/) NOEXCEPT {
+  return nullptr; // read-only view
+}
+
+bool compound_directory::exists(
+    bool& result, const std::string& name) const NOEXCEPT {
+  if (find(name)) {
+    result = true;
+
+    return true;
+  }
+
+  return dir_.exists(result, name);
+}
+
+bool compound_directory::length(
+    uint64_t& result, const std::string& name) const NOEXCEPT {
+  auto* entry = find(name);
+
+  if (entry) {
+    result = entry->length;
+
+    return true;
+  }
+
+  return dir_.length(result, name);
+}
+
+index_lock::ptr compound_directory::make_lock(
+    const std::string& /*name*/) NOEXCEPT {
+  return nullptr; // read-only view
+}
+
+bool compound_directory::mtime(
+    std::time_t& result, const std::string& name) const NOEXCEPT {
+  return dir_.mtime(result, find(name) ? file_name(segment_) : name);
+}
+
+index_input::ptr compound_directory::open(
+    const std::string& name,
+    IOAdvice advice) const NOEXCEPT {
+  auto* entry = find(name);
+
+  if (!entry) {
+    return dir_.open(name, advice);
+  }
+
+  auto in = in_->reopen(); // thread-safe handle to the compound file
+
+  if (!in) {
+    IR_FRMT_ERROR(
+      "Failed to reopen compound file of segment '%s'", segment_.c_str()
+    );
+
+    return nullptr;
+  }
+
+  try {
+    in->seek(entry->offset);
+
+    return memory::make_unique<range_index_input>(
+      std::move(in), entry->offset, entry->length
+    );
+  } catch (...) {
+    IR_LOG_EXCEPTION();
+  }
+
+  return nullptr;
+}
+
+bool compound_directory::remove(const std::string& /*name*/) NOEXCEPT {
+  return false; // read-only view
+}
+
+bool compound_directory::rename(
+    const std::string& /*src*/, const std::string& /*dst*/) NOEXCEPT {
+  return false; // read-only view
+}
+
+bool compound_directory::sync(const std::string& /*name*/) NOEXCEPT {
+  return false; // read-only view
+}
+
+bool compound_directory::visit(const visitor_f& visitor) const {
+  std::string name;
+
+  for (auto& entry : entries_) {
+    name = segment_;
+    name += entry.first;
+
+    if (!visitor(name)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+NS_END
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_COMPOUND_DIRECTORY_H
+#define IRESEARCH_COMPOUND_DIRECTORY_H
+
+#include "directory.hpp"
+#include "utils/string.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class compound_directory
+/// @brief read-only view over a compound file of a segment, i.e. a single file
+///        containing the contents of several segment files, contained files
+///        are served as ranges of the compound file, all other files are
+///        served by the underlying directory
+/// @note file names of a compound file are stored relative to the segment
+///       name, so that a compound file may be renamed together with a segment
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API compound_directory final : public directory {
+ public:
+  static const string_ref FORMAT_EXT;
+  static const string_ref FORMAT_NAME;
+  static const int32_t FORMAT_MIN = 0;
+  static const int32_t FORMAT_MAX = FORMAT_MIN;
+
+  DECLARE_UNIQUE_PTR(compound_directory);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return name of the compound file of the specified segment
+  //////////////////////////////////////////////////////////////////////////////
+  static std::string file_name(const string_ref& segment);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief opens a view over the compound file of the specified segment
+  /// @return nullptr if the compound file can't be opened
+  /// @throws index_error if the compound file is corrupted
+  //////////////////////////////////////////////////////////////////////////////
+  static ptr open(const directory& dir, const std::string& segment);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief writes the specified files of the segment into the compound file
+  ///        of the segment, names of files must start with the segment name
+  /// @note files are not removed
+  /// @return success
+  //////////////////////////////////////////////////////////////////////////////
+  static bool write(
+    directory& dir,
+    const std::string& segment,
+    const std::vector<std::string>& files
+  );
+
+  using directory::attributes;
+  virtual attribute_store& attributes() NOEXCEPT override;
+  virtual void close() NOEXCEPT override;
+  virtual index_output::ptr create(const std::string& name) NOEXCEPT override;
+  virtual bool exists(
+    bool& result, const std::string& name
+  ) const NOEXCEPT override;
+  virtual bool length(
+    uint64_t& result, const std::string& name
+  ) const NOEXCEPT override;
+  virtual index_lock::ptr make_lock(const std::string& name) NOEXCEPT override;
+  virtual bool mtime(
+    std::time_t& result, const std::string& name
+  ) const NOEXCEPT override;
+  virtual index_input::ptr open(
+    const std::string& name,
+    IOAdvice advice
+  ) const NOEXCEPT override;
+  virtual bool remove(const std::string& name) NOEXCEPT override;
+  virtual bool rename(
+    const std::string& src, const std::string& dst
+  ) NOEXCEPT override;
+  virtual bool sync(const std::string& name) NOEXCEPT override;
+  virtual bool visit(const visitor_f& visitor) const override;
+
+ private:
+  struct entry {
+    uint64_t offset;
+    uint64_t length;
+  };
+
+  typedef std::unordered_map<std::string, entry> entries_t;
+
+  compound_directory(
+    const directory& dir,
+    const std::string& segment,
+    index_input::ptr&& in,
+    entries_t&& entries
+  ) NOEXCEPT;
+
+  const entry* find(const std::string& name) const NOEXCEPT;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  const directory& dir_;
+  entries_t entries_; // by name relative to the segment name
+  index_input::ptr in_; // compound file
+  std::string segment_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // compound_directory
+
+NS_END
+
+#endif
@@ -23,6 +23,8 @@
 
 #include "error/error.hpp"
 #include "directory_attributes.hpp"
+#include "utils/huge_pages.hpp"
+#include "utils/numa_utils.hpp"
 
 NS_LOCAL
 
@@ -41,7 +43,15 @@ DEFINE_ATTRIBUTE_TYPE(memory_allocator);
 /*static*/ memory_allocator::buffer::ptr memory_allocator::buffer::make(
     size_t size
 ) {
-  return memory::make_unique<byte_type[]>(size);
+  auto buf = memory::make_unique<byte_type[]>(size);
+
+  if (size >= memory::HUGE_PAGE_SIZE
+      && memory::huge_pages_mode::NONE != memory::huge_pages()) {
+    // buffer is released via delete[], so only transparent huge pages apply
+    memory::advise_huge_pages(buf.get(), size);
+  }
+
+  return buf;
 }
 
 /*static*/ memory_allocator& memory_allocator::global() NOEXCEPT {
@@ -52,8 +62,25 @@ DEFINE_ATTRIBUTE_TYPE(memory_allocator);
   return memory::make_unique<memory_allocator>(pool_size);
 }
 
-memory_allocator::memory_allocator(size_t pool_size)
-  : allocator_(pool_size) {
+memory_allocator::memory_allocator(size_t pool_size) {
+  const auto nodes = numa_utils::nodes();
+
+  allocators_.reserve(nodes);
+
+  for (size_t i = 0; i < nodes; ++i) {
+    allocators_.emplace_back(memory::make_unique<allocator_type>(pool_size));
+  }
+}
+
+memory_allocator::operator allocator_type&() const NOEXCEPT {
+  return 1 == allocators_.size()
+    ? *allocators_.front()
+    : node(numa_utils::current_node());
+}
+
+memory_allocator::allocator_type& memory_allocator::node(
+    size_t node) const NOEXCEPT {
+  return *allocators_[node % allocators_.size()];
 }
 
 // -----------------------------------------------------------------------------
@@ -29,6 +29,9 @@
 #include "utils/ref_counter.hpp"
 #include "utils/container_utils.hpp"
 
+#include <memory>
+#include <vector>
+
 NS_ROOT
 
 //////////////////////////////////////////////////////////////////////////////
@@ -53,14 +56,26 @@ class IRESEARCH_API memory_allocator : public stored_attribute {
 
   static memory_allocator& global() NOEXCEPT;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param pool_size size of the buffer pool of each NUMA node
+  //////////////////////////////////////////////////////////////////////////////
   explicit memory_allocator(size_t pool_size);
 
-  operator allocator_type&() const NOEXCEPT {
-    return const_cast<allocator_type&>(allocator_);
-  }
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return allocator local to the NUMA node of the current thread, i.e.
+  ///         buffers are reused by threads of the node that touched them first
+  //////////////////////////////////////////////////////////////////////////////
+  operator allocator_type&() const NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return allocator of the specified NUMA node
+  //////////////////////////////////////////////////////////////////////////////
+  allocator_type& node(size_t node) const NOEXCEPT;
 
  private:
-  allocator_type allocator_;
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::vector<std::unique_ptr<allocator_type>> allocators_; // by NUMA node
+  IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // memory_allocator
 
 //////////////////////////////////////////////////////////////////////////////
@@ -391,7 +391,7 @@ attribute_store& memory_directory::attributes() NOEXCEPT {
 }
 
 void memory_directory::close() NOEXCEPT {
-  async_utils::read_write_mutex::write_mutex mutex(flock_);
+  async_utils::distributed_read_write_mutex::write_mutex mutex(flock_);
   SCOPED_LOCK(mutex);
 
   files_.clear();
@@ -400,7 +400,7 @@ void memory_directory::close() NOEXCEPT {
 bool memory_directory::exists(
   bool& result, const std::string& name
 ) const NOEXCEPT {
-  async_utils::read_write_mutex::read_mutex mutex(flock_);
+  async_utils::distributed_read_write_mutex::read_mutex mutex(flock_);
   SCOPED_LOCK(mutex);
 
   result = files_.find(name) != files_.end();
@@ -410,7 +410,7 @@ bool memory_directory::exists(
 
 index_output::ptr memory_directory::create(const std::string& name) NOEXCEPT {
   try {
-    async_utils::read_write_mutex::write_mutex mutex(flock_);
+    async_utils::distributed_read_write_mutex::write_mutex mutex(flock_);
     SCOPED_LOCK(mutex);
 
     auto res = files_.emplace(
@@ -438,7 +438,7 @@ index_output::ptr memory_directory::create(const std::string& name) NOEXCEPT {
 bool memory_directory::length(
     uint64_t& result, const std::string& name
 ) const NOEXCEPT {
-  async_utils::read_write_mutex::read_mutex mutex(flock_);
+  async_utils::distributed_read_write_mutex::read_mutex mutex(flock_);
   SCOPED_LOCK(mutex);
 
   const auto it = files_.find(name);
@@ -469,7 +469,7 @@ bool memory_directory::mtime(
     std::time_t& result,
     const std::string& name
 ) const NOEXCEPT {
-  async_utils::read_write_mutex::read_mutex mutex(flock_);
+  async_utils::distributed_read_write_mutex::read_mutex mutex(flock_);
   SCOPED_LOCK(mutex);
 
   const auto it = files_.find(name);
@@ -488,7 +488,7 @@ index_input::ptr memory_directory::open(
     IOAdvice /*advice*/
 ) const NOEXCEPT {
   try {
-    async_utils::read_write_mutex::read_mutex mutex(flock_);
+    async_utils::distributed_read_write_mutex::read_mutex mutex(flock_);
     SCOPED_LOCK(mutex);
 
     const auto it = files_.find(name);
@@ -509,7 +509,7 @@ index_input::ptr memory_directory::open(
 
 bool memory_directory::remove(const std::string& name) NOEXCEPT {
   try {
-    async_utils::read_write_mutex::write_mutex mutex(flock_);
+    async_utils::distributed_read_write_mutex::write_mutex mutex(flock_);
     SCOPED_LOCK(mutex);
 
     return files_.erase(name) > 0;
@@ -524,7 +524,7 @@ bool memory_directory::rename(
     const std::string& src, const std::string& dst
 ) NOEXCEPT {
   try {
-    async_utils::read_write_mutex::write_mutex mutex(flock_);
+    async_utils::distributed_read_write_mutex::write_mutex mutex(flock_);
     SCOPED_LOCK(mutex);
 
     auto it = files_.find(src);
@@ -555,7 +555,7 @@ bool memory_directory::visit(const directory::visitor_f& visitor) const {
   // take a snapshot of existing files in directory
   // to avoid potential recursive read locks in visitor
   {
-    async_utils::read_write_mutex::read_mutex mutex(flock_);
+    async_utils::distributed_read_write_mutex::read_mutex mutex(flock_);
     SCOPED_LOCK(mutex);
 
     files.reserve(files_.size());
@@ -314,7 +314,7 @@ class IRESEARCH_API memory_directory final : public directory {
 
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   const memory_allocator* alloc_;
-  mutable async_utils::read_write_mutex flock_;
+  mutable async_utils::distributed_read_write_mutex flock_;
   std::mutex llock_;
   attribute_store attributes_;
   file_map files_;
@@ -68,7 +68,8 @@ class mmap_index_input : public irs::bytes_ref_input {
  public:
   static irs::index_input::ptr open(
       const file_path_t file,
-      irs::IOAdvice advice) NOEXCEPT {
+      irs::IOAdvice advice,
+      size_t huge_pages_min_size) NOEXCEPT {
     assert(file);
 
     mmap_handle_ptr handle;
@@ -91,6 +92,16 @@ class mmap_index_input : public irs::bytes_ref_input {
       IR_FRMT_ERROR("Failed to madvise input file, path: " IR_FILEPATH_SPECIFIER ", error %d", file, errno);
     }
 
+    // huge pages are pointless for files which are read once
+    if (huge_pages_min_size
+        && handle->size() >= huge_pages_min_size
+        && !bool(advice & irs::IOAdvice::READONCE)
+        && IR_MADVICE_HUGEPAGE
+        && !handle->advise(IR_MADVICE_HUGEPAGE)) {
+      // not supported for file mappings by every kernel/filesystem
+      IR_FRMT_DEBUG("Failed to request huge pages for input file, path: " IR_FILEPATH_SPECIFIER ", error %d", file, errno);
+    }
+
     handle->dontneed(bool(advice & irs::IOAdvice::READONCE));
 
     return mmap_index_input::make<mmap_index_input>(std::move(handle));
@@ -133,8 +144,11 @@ NS_ROOT
 // --SECTION--                                     mmap_directory implementation
 // -----------------------------------------------------------------------------
 
-mmap_directory::mmap_directory(const std::string& path)
-  : fs_directory(path) {
+mmap_directory::mmap_directory(
+    const std::string& path,
+    size_t huge_pages_min_size /*= 0*/)
+  : fs_directory(path),
+    huge_pages_min_size_(huge_pages_min_size) {
 }
 
 index_input::ptr mmap_directory::open(
@@ -149,7 +163,7 @@ index_input::ptr mmap_directory::open(
     return nullptr;
   }
 
-  return mmap_index_input::open(path.c_str(), advice);
+  return mmap_index_input::open(path.c_str(), advice, huge_pages_min_size_);
 }
 
 NS_END // ROOT
@@ -33,12 +33,22 @@ NS_ROOT
 //////////////////////////////////////////////////////////////////////////////
 class IRESEARCH_API mmap_directory : public fs_directory {
  public:
-  explicit mmap_directory(const std::string& dir);
+  ////////////////////////////////////////////////////////////////////////////
+  /// @param huge_pages_min_size request transparent huge pages for mappings
+  ///        of files not smaller than the specified size, 0 == disabled
+  ////////////////////////////////////////////////////////////////////////////
+  explicit mmap_directory(
+    const std::string& dir,
+    size_t huge_pages_min_size = 0
+  );
 
   virtual index_input::ptr open(
     const std::string& name,
     IOAdvice advice
   ) const NOEXCEPT override final;
+
+ private:
+  size_t huge_pages_min_size_;
 }; // mmap_directory
 
 NS_END // ROOT
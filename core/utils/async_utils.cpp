@@ -22,15 +22,67 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <cassert>
+#include <cstdint>
+#include <new>
+#include <deque>
 
 #include "log.hpp"
+#include "memory.hpp"
+#include "numa_utils.hpp"
 #include "thread_utils.hpp"
 #include "async_utils.hpp"
 
+#if defined(_WIN32)
+  #include <Windows.h>
+#elif defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
 NS_LOCAL
 
 static std::thread::id INVALID;
 
+const size_t PRIORITY_COUNT = 3; // number of task_scheduler::priority values
+const size_t CACHE_LINE_SIZE = 64; // common for x86_64 and ARMv8
+const size_t MAX_READER_SLOTS = 256; // arbitrary size
+
+// scheduler and worker the current thread belongs to (if any)
+thread_local const irs::async_utils::task_scheduler* CURRENT_SCHEDULER = nullptr;
+thread_local size_t CURRENT_WORKER = 0;
+
+// reader counter offset of the current thread, computed once per thread
+thread_local const size_t THREAD_SLOT
+  = std::hash<std::thread::id>()(std::this_thread::get_id()) * 0x9E3779B97F4A7C15ULL >> 32;
+
+void pin_current_thread(size_t id) {
+  const size_t cpus = std::thread::hardware_concurrency();
+
+  if (!cpus) {
+    return; // number of CPUs is not known
+  }
+
+  const size_t cpu = id % cpus;
+
+  #if defined(_WIN32)
+    if (cpu < sizeof(DWORD_PTR) * 8
+        && !SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu)) {
+      IR_FRMT_WARN("Failed to pin worker '" IR_SIZE_T_SPECIFIER "' to CPU '" IR_SIZE_T_SPECIFIER "'", id, cpu);
+    }
+  #elif defined(__linux__)
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof set, &set)) {
+      IR_FRMT_WARN("Failed to pin worker '" IR_SIZE_T_SPECIFIER "' to CPU '" IR_SIZE_T_SPECIFIER "'", id, cpu);
+    }
+  #else
+    UNUSED(cpu); // thread affinity is not supported
+  #endif
+}
+
 NS_END
 
 NS_ROOT
@@ -215,6 +267,213 @@ void read_write_mutex::unlock(bool exclusive_only /*= false*/) {
   writer_cond_.notify_all();
 }
 
+distributed_read_write_mutex::distributed_read_write_mutex(
+    size_t slots /*= 0*/)
+  : exclusive_(false),
+    exclusive_owner_recursion_count_(0) {
+  if (!slots) {
+    slots = 2 * (std::max)(std::thread::hardware_concurrency(), 1U);
+  }
+
+  slots = (std::min)(slots, MAX_READER_SLOTS);
+
+  size_t count = 1;
+
+  while (count < slots) {
+    count <<= 1;
+  }
+
+  slots_mask_ = count - 1;
+  counters_buf_.reset(new char[(count + 1) * CACHE_LINE_SIZE]);
+
+  const auto misalignment =
+    reinterpret_cast<uintptr_t>(counters_buf_.get()) % CACHE_LINE_SIZE;
+
+  counters_ = counters_buf_.get()
+    + (misalignment ? CACHE_LINE_SIZE - misalignment : 0);
+
+  for (size_t i = 0; i < count; ++i) {
+    new (counters_ + i * CACHE_LINE_SIZE) std::atomic<int64_t>(0);
+  }
+}
+
+distributed_read_write_mutex::~distributed_read_write_mutex() {
+  TRY_SCOPED_LOCK_NAMED(mutex_, lock);
+  assert(lock && !has_readers());
+  UNUSED(lock);
+  // std::atomic<int64_t> is trivially destructible
+}
+
+bool distributed_read_write_mutex::has_readers() const NOEXCEPT {
+  int64_t count = 0;
+
+  // a reader may release its lock via a counter other than the acquiring
+  // one, hence only the total is meaningful
+  for (size_t i = 0; i <= slots_mask_; ++i) {
+    count += reinterpret_cast<std::atomic<int64_t>*>(
+      counters_ + i * CACHE_LINE_SIZE
+    )->load();
+  }
+
+  return 0 != count;
+}
+
+void distributed_read_write_mutex::lock_read() {
+  // if have write lock
+  if (owns_write()) {
+    ++exclusive_owner_recursion_count_; // write recursive lock
+
+    return;
+  }
+
+  auto& counter = slot();
+
+  for (;;) {
+    ++counter;
+
+    if (!exclusive_.load()) {
+      return;
+    }
+
+    // yield to a writer waiting or holding the lock
+    --counter;
+    notify(); // the writer might have seen the increment
+
+    SCOPED_LOCK_NAMED(wait_mutex_, lock);
+
+    while (exclusive_.load()) {
+      cond_.wait_for(lock, std::chrono::milliseconds(1000));
+    }
+  }
+}
+
+void distributed_read_write_mutex::lock_write() {
+  // if have write lock
+  if (owns_write()) {
+    ++exclusive_owner_recursion_count_; // write recursive lock
+
+    return;
+  }
+
+  mutex_.lock(); // held until unlock()
+  exclusive_.store(true); // new readers yield from now on
+
+  {
+    SCOPED_LOCK_NAMED(wait_mutex_, lock);
+
+    // wait until existing readers release their locks
+    while (has_readers()) {
+      cond_.wait_for(lock, std::chrono::milliseconds(1000));
+    }
+  }
+
+  exclusive_owner_.store(std::this_thread::get_id());
+}
+
+void distributed_read_write_mutex::notify() NOEXCEPT {
+  SCOPED_LOCK(wait_mutex_);
+  cond_.notify_all();
+}
+
+bool distributed_read_write_mutex::owns_write() {
+  return exclusive_owner_.load() == std::this_thread::get_id();
+}
+
+std::atomic<int64_t>& distributed_read_write_mutex::slot() const NOEXCEPT {
+  return *reinterpret_cast<std::atomic<int64_t>*>(
+    counters_ + (THREAD_SLOT & slots_mask_) * CACHE_LINE_SIZE
+  );
+}
+
+bool distributed_read_write_mutex::try_lock_read() {
+  // if have write lock
+  if (owns_write()) {
+    ++exclusive_owner_recursion_count_; // write recursive lock
+
+    return true;
+  }
+
+  auto& counter = slot();
+
+  ++counter;
+
+  if (!exclusive_.load()) {
+    return true;
+  }
+
+  --counter;
+  notify(); // the writer might have seen the increment
+
+  return false;
+}
+
+bool distributed_read_write_mutex::try_lock_write() {
+  // if have write lock
+  if (owns_write()) {
+    ++exclusive_owner_recursion_count_; // write recursive lock
+
+    return true;
+  }
+
+  if (!mutex_.try_lock()) {
+    return false;
+  }
+
+  exclusive_.store(true);
+
+  if (has_readers()) {
+    exclusive_.store(false);
+    mutex_.unlock();
+    notify(); // wake readers which yielded in the meantime
+
+    return false;
+  }
+
+  exclusive_owner_.store(std::this_thread::get_id());
+
+  return true;
+}
+
+void distributed_read_write_mutex::unlock(bool exclusive_only /*= false*/) {
+  // if have write lock
+  if (owns_write()) {
+    if (exclusive_owner_recursion_count_) {
+      if (!exclusive_only) { // a recursively locked mutex is alway top-level write locked
+        --exclusive_owner_recursion_count_; // write recursion unlock one level
+      }
+
+      return;
+    }
+
+    static std::thread::id unowned;
+
+    if (exclusive_only) {
+      ++slot(); // aquire the read-lock
+    }
+
+    exclusive_owner_.store(unowned);
+    exclusive_.store(false);
+    mutex_.unlock();
+    notify(); // wake all reader and writers
+
+    return;
+  }
+
+  if (exclusive_only) {
+    return; // NOOP for readers
+  }
+
+  // ...........................................................................
+  // after here assume have read lock
+  // ...........................................................................
+
+  --slot();
+
+  if (exclusive_.load()) {
+    notify(); // wake the writer waiting for readers
+  }
+}
+
 thread_pool::thread_pool(size_t max_threads /*= 0*/, size_t max_idle /*= 0*/):
   active_(0), max_idle_(max_idle), max_threads_(max_threads), state_(State::RUN) {
 }
@@ -409,6 +668,337 @@ void thread_pool::run() {
   }
 }
 
+struct task_scheduler::worker {
+  std::mutex lock; // contended only by thieves and external submissions
+  std::deque<std::function<void()>> queues[PRIORITY_COUNT];
+  std::thread thread;
+};
+
+task_scheduler::task_group::task_group(
+    task_scheduler* scheduler,
+    priority prio /*= priority::QUERY*/) NOEXCEPT
+  : pending_(0), priority_(prio), scheduler_(scheduler) {
+}
+
+task_scheduler::task_group::~task_group() {
+  try {
+    wait();
+  } catch (...) {
+    IR_LOG_EXCEPTION(); // subtasks reference the group, must wait for them
+  }
+}
+
+void task_scheduler::task_group::run(std::function<void()>&& fn) {
+  ++pending_;
+
+  // std::function since passing a lambda to run(...) would move it into a
+  // temporary even if the scheduler rejects the task
+  std::function<void()> task = [this, fn]()->void {
+    try {
+      fn();
+    } catch (...) {
+      SCOPED_LOCK(lock_);
+
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+
+    finish(); // must be the last access to the group
+  };
+
+  try {
+    if (!scheduler_ || !scheduler_->run(std::move(task), priority_)) {
+      task(); // no scheduler or it is stopped, run on the current thread
+    }
+  } catch (...) {
+    finish(); // failed to schedule, 'task' does not throw
+
+    throw;
+  }
+}
+
+void task_scheduler::task_group::finish() NOEXCEPT {
+  // decrement under the lock, wait() acquires it before returning, i.e.
+  // the group is not destroyed until 'lock_' is released here
+  SCOPED_LOCK(lock_);
+
+  if (!--pending_) {
+    cond_.notify_all();
+  }
+}
+
+void task_scheduler::task_group::wait() {
+  while (pending_.load()) {
+    // help executing pending tasks instead of blocking, this allows subtasks
+    // to fork and join groups of their own without exhausting the workers
+    if (scheduler_ && scheduler_->run_one()) {
+      continue;
+    }
+
+    // remaining subtasks are being executed by other threads, each of them
+    // executes subtasks it forks while waiting for them
+    SCOPED_LOCK_NAMED(lock_, lock);
+
+    while (pending_.load()) {
+      cond_.wait(lock);
+    }
+  }
+
+  std::exception_ptr error;
+
+  {
+    SCOPED_LOCK(lock_); // synchronize with finish() of the last subtask
+    std::swap(error, error_);
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+task_scheduler::task_scheduler(const options& opts /*= options()*/)
+  : next_(0),
+    pending_(0),
+    queued_(0),
+    sleeping_(0),
+    state_(State::RUN) {
+  auto threads = opts.threads ? opts.threads : std::thread::hardware_concurrency();
+
+  workers_.reserve((std::max)(threads, size_t(1)));
+
+  for (size_t i = 0, count = workers_.capacity(); i < count; ++i) {
+    workers_.emplace_back(memory::make_unique<worker>());
+  }
+
+  // start threads after all workers are created since workers steal from
+  // each other
+  try {
+    for (size_t i = 0, count = workers_.size(); i < count; ++i) {
+      workers_[i]->thread = std::thread(
+        &task_scheduler::run_worker, this, i, opts
+      );
+    }
+  } catch (...) {
+    stop(true); // join already started threads
+
+    throw;
+  }
+}
+
+task_scheduler::~task_scheduler() {
+  stop();
+}
+
+bool task_scheduler::execute(size_t start) {
+  std::function<void()> fn;
+
+  if (!take(start, fn)) {
+    return false;
+  }
+
+  try {
+    fn();
+  } catch (...) {
+    IR_LOG_EXCEPTION();
+  }
+
+  return true;
+}
+
+bool task_scheduler::run(
+    std::function<void()>&& fn,
+    priority prio /*= priority::FLUSH*/) {
+  // count the task before checking the state so that finishing workers do
+  // not terminate before the task is queued
+  ++pending_;
+
+  if (State::RUN != state_.load()) {
+    --pending_;
+    notify(true); // finishing workers may wait for 'pending_' to drop
+
+    return false; // scheduler is stopped
+  }
+
+  auto& queue_owner = CURRENT_SCHEDULER == this
+    ? *workers_[CURRENT_WORKER] // keep forked subtasks local to the worker
+    : *workers_[next_++ % workers_.size()];
+
+  try {
+    SCOPED_LOCK(queue_owner.lock);
+    queue_owner.queues[size_t(prio)].emplace_back(std::move(fn));
+    ++queued_;
+  } catch (...) {
+    --pending_;
+    notify(true);
+
+    throw;
+  }
+
+  notify(false);
+
+  return true;
+}
+
+void task_scheduler::notify(bool all) NOEXCEPT {
+  if (!sleeping_.load()) {
+    return; // a worker going to sleep re-checks 'queued_' and 'pending_'
+  }
+
+  SCOPED_LOCK(sleep_lock_); // ensure the worker is either waiting or will see the change
+
+  if (all) {
+    cond_.notify_all();
+  } else {
+    cond_.notify_one();
+  }
+}
+
+bool task_scheduler::run_one() {
+  return execute(
+    CURRENT_SCHEDULER == this ? CURRENT_WORKER : next_++ % workers_.size()
+  );
+}
+
+void task_scheduler::run_worker(size_t id, const options& opts) {
+  CURRENT_SCHEDULER = this;
+  CURRENT_WORKER = id;
+
+  if (opts.pin_threads) {
+    pin_current_thread(id);
+  } else if (opts.bind_numa_nodes && numa_utils::nodes() > 1) {
+    numa_utils::bind_current_thread(id % numa_utils::nodes());
+  }
+
+  for (;;) {
+    if (State::ABORT == state_.load()) {
+      return; // pending tasks are dropped
+    }
+
+    if (execute(id)) {
+      continue;
+    }
+
+    SCOPED_LOCK_NAMED(sleep_lock_, lock);
+
+    if (!pending_.load() && State::RUN != state_.load()) {
+      return; // all pending tasks are finished
+    }
+
+    ++sleeping_;
+
+    // tasks counted in 'pending_' but not in 'queued_' are being submitted,
+    // run(...) signals once they are either queued or rejected,
+    // re-check periodically to guard against missed notifications
+    while (!queued_.load()
+           && State::ABORT != state_.load()
+           && (pending_.load() || State::RUN == state_.load())) {
+      cond_.wait_for(lock, std::chrono::milliseconds(1000));
+    }
+
+    --sleeping_;
+  }
+}
+
+void task_scheduler::stop(bool skip_pending /*= false*/) {
+  SCOPED_LOCK(stop_lock_);
+
+  {
+    SCOPED_LOCK(sleep_lock_);
+    auto expected = State::RUN;
+
+    if (skip_pending) {
+      state_.store(State::ABORT);
+    } else {
+      state_.compare_exchange_strong(expected, State::FINISH);
+    }
+
+    cond_.notify_all(); // wake all workers
+  }
+
+  for (auto& entry : workers_) {
+    if (entry->thread.joinable()) {
+      entry->thread.join();
+    }
+  }
+
+  // drop tasks left after an abort
+  for (auto& entry : workers_) {
+    SCOPED_LOCK(entry->lock);
+
+    for (auto& queue : entry->queues) {
+      pending_ -= queue.size();
+      queued_ -= queue.size();
+      queue.clear();
+    }
+  }
+}
+
+bool task_scheduler::take(size_t start, std::function<void()>& fn) {
+  // tasks of the own queue are taken in LIFO order (recently forked subtasks
+  // are likely to be hot in cache), tasks of other workers are stolen in FIFO
+  // order (older tasks tend to be larger), higher priorities are taken first
+  // 'pending_' is decremented before 'queued_' so that a finishing worker
+  // which sees no queued tasks sees no pending ones either
+  auto taken = [this]()->void {
+    --pending_;
+    --queued_;
+  };
+
+  for (size_t prio = 0; prio < PRIORITY_COUNT; ++prio) {
+    if (CURRENT_SCHEDULER == this) {
+      auto& own = *workers_[CURRENT_WORKER];
+      SCOPED_LOCK(own.lock);
+      auto& queue = own.queues[prio];
+
+      if (!queue.empty()) {
+        fn = std::move(queue.back());
+        queue.pop_back();
+        taken();
+
+        return true;
+      }
+    }
+
+    bool contended = false;
+
+    // steal from uncontended queues first, then wait for contended ones
+    for (size_t pass = 0; !pass || (pass == 1 && contended); ++pass) {
+      for (size_t i = 0, count = workers_.size(); i < count; ++i) {
+        const auto victim = (start + i) % count;
+
+        if (CURRENT_SCHEDULER == this && victim == CURRENT_WORKER) {
+          continue; // already checked
+        }
+
+        auto& entry = *workers_[victim];
+        TRY_SCOPED_LOCK_NAMED(entry.lock, lock);
+
+        if (!lock) {
+          if (!pass) {
+            contended = true;
+            continue;
+          }
+
+          lock.lock();
+        }
+
+        auto& queue = entry.queues[prio];
+
+        if (!queue.empty()) {
+          fn = std::move(queue.front());
+          queue.pop_front();
+          taken();
+
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
 NS_END
 NS_END
 
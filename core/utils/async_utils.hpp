@@ -26,7 +26,9 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <exception>
 #include <functional>
+#include <memory>
 #include <queue>
 #include <thread>
 
@@ -117,6 +119,80 @@ class IRESEARCH_API read_write_mutex final {
    IRESEARCH_API_PRIVATE_VARIABLES_END
 };
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief a reader-biased read-write mutex for read-dominated structures
+///        readers only modify one of several counters selected by the current
+///        thread, counters reside on separate cache lines, i.e. concurrent
+///        readers do not contend on a shared cache line
+///        writers are serialized and wait until all counters sum up to zero
+///        supports the same semantics as read_write_mutex (recursion,
+///        downgrading, write-lock acquisition preference)
+/// @note a read-lock may be released by a thread other than the one that
+///       acquired it
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API distributed_read_write_mutex final
+    : private util::noncopyable {
+ public:
+  // for use with std::lock_guard/std::unique_lock for read operations
+  class read_mutex {
+   public:
+    read_mutex(distributed_read_write_mutex& mutex): mutex_(mutex) {}
+    read_mutex& operator=(read_mutex&) = delete; // because of reference
+    void lock() { mutex_.lock_read(); }
+    bool try_lock() { return mutex_.try_lock_read(); }
+    void unlock() { mutex_.unlock(); }
+   private:
+    distributed_read_write_mutex& mutex_;
+  };
+
+  // for use with std::lock_guard/std::unique_lock for write operations
+  class write_mutex {
+   public:
+    write_mutex(distributed_read_write_mutex& mutex): mutex_(mutex) {}
+    write_mutex& operator=(write_mutex&) = delete; // because of reference
+    void lock() { mutex_.lock_write(); }
+    bool owns_write() { return mutex_.owns_write(); }
+    bool try_lock() { return mutex_.try_lock_write(); }
+    void unlock(bool exclusive_only = false) { mutex_.unlock(exclusive_only); }
+   private:
+    distributed_read_write_mutex& mutex_;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @param slots number of reader counters (rounded up to a power of 2,
+  ///        at most 256), 0 == twice the number of hardware threads
+  ////////////////////////////////////////////////////////////////////////////
+  explicit distributed_read_write_mutex(size_t slots = 0);
+  ~distributed_read_write_mutex();
+
+  void lock_read();
+  void lock_write();
+  bool owns_write();
+  bool try_lock_read();
+  bool try_lock_write();
+
+  // The mutex must be locked by the current thread of execution, otherwise, the behavior is undefined.
+  // @param exclusive_only if true then only downgrade a lock to a read-lock
+  void unlock(bool exclusive_only = false);
+
+ private:
+  bool has_readers() const NOEXCEPT;
+  void notify() NOEXCEPT; // wake all waiting readers and writers
+  std::atomic<int64_t>& slot() const NOEXCEPT; // counter of the current thread
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::condition_variable cond_;
+  std::unique_ptr<char[]> counters_buf_; // storage for reader counters
+  char* counters_; // cache line aligned reader counters
+  std::atomic<bool> exclusive_; // a writer holds or waits for the lock
+  std::atomic<std::thread::id> exclusive_owner_;
+  size_t exclusive_owner_recursion_count_;
+  std::mutex mutex_; // held by the writer
+  size_t slots_mask_;
+  std::mutex wait_mutex_; // guards waiting on 'cond_'
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+};
+
 class IRESEARCH_API thread_pool {
  public:
   explicit thread_pool(size_t max_threads = 0, size_t max_idle = 0);
@@ -147,6 +223,134 @@ class IRESEARCH_API thread_pool {
    void run();
 };
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief a fixed-size pool of worker threads with a separate task queue per
+///        worker, i.e. submissions and pickups do not serialize on a single
+///        lock: tasks submitted by a worker are put into its own queue and
+///        taken back in LIFO order, idle workers steal tasks in FIFO order
+///        from the queues of other workers, tasks submitted by other threads
+///        are distributed across workers in a round-robin manner
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API task_scheduler : private util::noncopyable {
+ public:
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief task priority, pending tasks of a higher priority are taken first
+  ////////////////////////////////////////////////////////////////////////////
+  enum class priority {
+    QUERY = 0, // latency sensitive tasks
+    FLUSH, // tasks blocking a commit
+    MERGE // background tasks
+  };
+
+  struct options {
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief number of worker threads
+    ///        0 == std::thread::hardware_concurrency()
+    ////////////////////////////////////////////////////////////////////////////
+    size_t threads{0};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief pin worker 'i' to CPU 'i % std::thread::hardware_concurrency()'
+    /// @note ignored on platforms without thread affinity support
+    ////////////////////////////////////////////////////////////////////////////
+    bool pin_threads{false};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief bind worker 'i' to the CPUs of NUMA node 'i % numa_utils::nodes()'
+    ///        so that memory first touched by tasks is local to the worker
+    /// @note ignored if 'pin_threads' is set, a NOOP on single-node hosts
+    ////////////////////////////////////////////////////////////////////////////
+    bool bind_numa_nodes{false};
+
+    options() {} // GCC5 requires non-default definition
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief a set of subtasks forked from the current thread which may be
+  ///        joined via wait(), subtasks may fork groups of their own
+  ////////////////////////////////////////////////////////////////////////////
+  class IRESEARCH_API task_group : private util::noncopyable {
+   public:
+    //////////////////////////////////////////////////////////////////////////
+    /// @param scheduler where to run subtasks, nullptr == run on the
+    ///        current thread during run(...)
+    //////////////////////////////////////////////////////////////////////////
+    explicit task_group(
+      task_scheduler* scheduler,
+      priority prio = priority::QUERY
+    ) NOEXCEPT;
+    ~task_group(); // waits for pending subtasks
+
+    void run(std::function<void()>&& fn);
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief wait for all subtasks of the group, the current thread executes
+    ///        pending tasks of the scheduler meanwhile and blocks once there
+    ///        are none left
+    /// @note rethrows the exception of the first failed subtask (if any)
+    //////////////////////////////////////////////////////////////////////////
+    void wait();
+
+   private:
+    void finish() NOEXCEPT; // account a finished subtask, wake up wait()
+
+    IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+    std::condition_variable cond_; // signaled when the last subtask finishes
+    std::exception_ptr error_; // exception of the first failed subtask
+    std::mutex lock_; // guards 'error_' and waiting on 'cond_'
+    std::atomic<size_t> pending_;
+    priority priority_;
+    task_scheduler* scheduler_;
+    IRESEARCH_API_PRIVATE_VARIABLES_END
+  }; // task_group
+
+  explicit task_scheduler(const options& opts = options());
+  ~task_scheduler(); // finishes pending tasks
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief schedule 'fn' for execution, exceptions thrown by 'fn' are logged
+  /// @return false if the scheduler is stopped
+  //////////////////////////////////////////////////////////////////////////////
+  bool run(std::function<void()>&& fn, priority prio = priority::FLUSH);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief execute a single pending task (if any) on the current thread
+  /// @return false if there were no pending tasks
+  //////////////////////////////////////////////////////////////////////////////
+  bool run_one();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief stop all workers, always a blocking call
+  /// @param skip_pending drop tasks that have not been started yet
+  /// @note must not be called from a task of the same scheduler
+  //////////////////////////////////////////////////////////////////////////////
+  void stop(bool skip_pending = false);
+
+  size_t tasks_pending() const NOEXCEPT { return pending_.load(); }
+  size_t threads() const NOEXCEPT { return workers_.size(); }
+
+ private:
+  struct worker;
+  enum class State { ABORT, FINISH, RUN };
+
+  bool execute(size_t start);
+  void notify(bool all) NOEXCEPT; // wake up sleeping workers (if any)
+  void run_worker(size_t id, const options& opts);
+  bool take(size_t start, std::function<void()>& fn);
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::condition_variable cond_; // signaled when tasks are submitted
+  std::atomic<size_t> next_; // round-robin counter for external submissions
+  std::atomic<size_t> pending_; // number of tasks not yet started
+  std::atomic<size_t> queued_; // number of tasks in worker queues
+  std::mutex sleep_lock_; // guards waiting on 'cond_'
+  std::atomic<size_t> sleeping_; // number of workers waiting on 'cond_'
+  std::atomic<State> state_;
+  std::mutex stop_lock_; // serializes stop(...)
+  std::vector<std::unique_ptr<worker>> workers_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // task_scheduler
+
 NS_END
 NS_END
 
@@ -36,6 +36,7 @@
 #include "noncopyable.hpp"
 #include "string.hpp"
 
+#include <array>
 #include <set>
 
 NS_ROOT
@@ -49,19 +50,40 @@ NS_ROOT
 ///          via DECLARE_ATTRIBUTE_TYPE()/DEFINE_ATTRIBUTE_TYPE(...)
 //////////////////////////////////////////////////////////////////////////////
 struct IRESEARCH_API attribute {
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fixed slots of the core attributes within attribute_map, such
+  ///        attributes are looked up on every iterator and scorer setup,
+  ///        lookups of slotted attributes don't touch the underlying map
+  //////////////////////////////////////////////////////////////////////////////
+  enum slot_t : size_t {
+    DOCUMENT = 0,
+    FREQUENCY,
+    POSITION,
+    OFFSET,
+    PAYLOAD,
+    COST,
+    SCORE,
+    SLOTS_COUNT, // number of fixed slots
+    NO_SLOT = SLOTS_COUNT // attribute is stored in the map only
+  };
+
   //////////////////////////////////////////////////////////////////////////////
   /// @class type_id 
   //////////////////////////////////////////////////////////////////////////////
   class IRESEARCH_API type_id: public iresearch::type_id, util::noncopyable {
    public:
-    type_id(const string_ref& name): name_(name) {}
+    type_id(const string_ref& name, slot_t slot = NO_SLOT)
+      : name_(name), slot_(slot) {
+    }
     operator const type_id*() const { return this; }
     static bool exists(const string_ref& name);
     static const type_id* get(const string_ref& name) NOEXCEPT;
     const string_ref& name() const { return name_; }
+    slot_t slot() const NOEXCEPT { return slot_; }
 
    private:
     string_ref name_;
+    slot_t slot_;
   }; // type_id
 };
 
@@ -90,6 +112,10 @@ struct IRESEARCH_API stored_attribute : attribute {
   return type; \
 }
 #define DEFINE_ATTRIBUTE_TYPE(class_type) DEFINE_ATTRIBUTE_TYPE_NAMED(class_type, #class_type)
+#define DEFINE_ATTRIBUTE_TYPE_SLOT(class_type, slot_name) DEFINE_TYPE_ID(class_type, ::iresearch::attribute::type_id) { \
+  static ::iresearch::attribute::type_id type(#class_type, ::iresearch::attribute::slot_name); \
+  return type; \
+}
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                            Attribute registration
@@ -311,17 +337,29 @@ template<
 
   attribute_map() = default;
 
-  attribute_map(const attribute_map& other) = default;
+  attribute_map(const attribute_map& other)
+    : map_(other.map_) {
+    reset_slots();
+  }
 
   attribute_map(attribute_map&& other) NOEXCEPT {
     *this = std::move(other);
   }
 
-  attribute_map& operator=(const attribute_map& other) = default;
+  attribute_map& operator=(const attribute_map& other) {
+    if (this != &other) {
+      map_ = other.map_;
+      reset_slots();
+    }
+
+    return *this;
+  }
 
   attribute_map& operator=(attribute_map&& other) NOEXCEPT {
     if (this != &other) {
       map_ = std::move(other.map_);
+      reset_slots();
+      other.reset_slots();
     }
 
     return *this;
@@ -329,9 +367,16 @@ template<
 
   void clear() {
     map_.clear();
+    slots_.fill(nullptr);
   }
 
   bool contains(const attribute::type_id& type) const NOEXCEPT {
+    const auto slot = type.slot();
+
+    if (slot < attribute::SLOTS_COUNT) {
+      return nullptr != slots_[slot];
+    }
+
     return map_.find(type) != map_.end();
   }
 
@@ -399,6 +444,12 @@ template<
   }
 
   bool remove(const attribute::type_id& type) {
+    const auto slot = type.slot();
+
+    if (slot < attribute::SLOTS_COUNT) {
+      slots_[slot] = nullptr;
+    }
+
     return map_.erase(&type) > 0;
   }
 
@@ -424,13 +475,25 @@ template<
  protected:
   typename ref<T>::type& emplace(bool& inserted, const attribute::type_id& type) {
     auto res = map_utils::try_emplace(map_, &type);
+    auto& value = res.first->second;
+    const auto slot = type.slot();
+
+    if (slot < attribute::SLOTS_COUNT) {
+      slots_[slot] = &value; // map nodes are never relocated
+    }
 
     inserted = res.second;
 
-    return res.first->second;
+    return value;
   }
 
   typename ref<T>::type* get(const attribute::type_id& type) NOEXCEPT {
+    const auto slot = type.slot();
+
+    if (slot < attribute::SLOTS_COUNT) {
+      return slots_[slot];
+    }
+
     auto itr = map_.find(&type);
 
     return map_.end() == itr ? nullptr : &(itr->second);
@@ -440,9 +503,9 @@ template<
       const attribute::type_id& type,
       typename ref<T>::type& fallback
   ) NOEXCEPT {
-    auto itr = map_.find(&type);
+    auto* value = get(type);
 
-    return map_.end() == itr ? fallback : itr->second;
+    return value ? *value : fallback;
   }
 
   const typename ref<T>::type& get(
@@ -455,9 +518,24 @@ template<
  private:
   // std::map<...> is 25% faster than std::unordered_map<...> as per profile_bulk_index test
   typedef std::map<const attribute::type_id*, typename ref<T>::type> map_t;
+  typedef std::array<typename ref<T>::type*, attribute::SLOTS_COUNT> slots_t;
+
+  // points slots to the entries of the map
+  void reset_slots() NOEXCEPT {
+    slots_.fill(nullptr);
+
+    for (auto& entry : map_) {
+      const auto slot = entry.first->slot();
+
+      if (slot < attribute::SLOTS_COUNT) {
+        slots_[slot] = &entry.second;
+      }
+    }
+  }
 
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   map_t map_;
+  slots_t slots_{}; // entries of the map for the attributes having fixed slots
   IRESEARCH_API_PRIVATE_VARIABLES_END
 
   template<typename Attributes, typename Visitor>
@@ -34,6 +34,7 @@
 #include <cstring>
 
 #include "memory.hpp"
+#include "huge_pages.hpp"
 #include "ebo.hpp"
 #include "bytes_utils.hpp"
 
@@ -720,17 +721,27 @@ struct proxy_block_t {
   size_t start; // where block starts
 }; // proxy_block_t
 
-template< typename T, size_t BlockSize, typename AllocType = std::allocator<T>>
-class block_pool {
+////////////////////////////////////////////////////////////////////////////////
+/// @tparam AllocType allocator of pool internals
+/// @tparam BlockAllocType allocator of data blocks, every pool gets its own
+///         huge page arena by default (if huge pages are enabled)
+////////////////////////////////////////////////////////////////////////////////
+template<
+  typename T,
+  size_t BlockSize,
+  typename AllocType = std::allocator<T>,
+  typename BlockAllocType = memory::huge_page_allocator<T>
+> class block_pool {
  public:
   typedef proxy_block_t<T, BlockSize> block_type;
   typedef AllocType allocator;
+  typedef BlockAllocType block_allocator;
   typedef typename allocator::value_type value_type;
   typedef typename allocator::reference reference;
   typedef typename allocator::const_reference const_reference;
   typedef typename allocator::pointer pointer;
   typedef typename allocator::const_pointer const_pointer;
-  typedef block_pool<value_type, BlockSize, allocator> my_type;
+  typedef block_pool<value_type, BlockSize, allocator, block_allocator> my_type;
 
   typedef block_pool_iterator<my_type> iterator;
   typedef block_pool_const_iterator<my_type> const_iterator;
@@ -741,15 +752,17 @@ class block_pool {
   typedef block_pool_inserter<my_type> inserter;
   typedef block_pool_sliced_inserter<my_type> sliced_inserter;
 
-  explicit block_pool(const allocator& alloc = allocator())
-    : rep_(blocks_t(block_ptr_allocator(alloc)), alloc) {
+  explicit block_pool(
+      const allocator& alloc = allocator(),
+      const block_allocator& block_alloc = block_allocator())
+    : rep_(blocks_t(block_ptr_allocator(alloc)), block_alloc) {
     static_assert(block_type::SIZE > 0, "block_type::SIZE == 0");
   }
 
   ~block_pool() {}
 
   void alloc_buffer(size_t count = 1) {
-    proxy_allocator proxy_alloc(get_allocator());
+    proxy_allocator proxy_alloc(get_block_allocator());
     auto& blocks = get_blocks();
 
     while (count--) {
@@ -888,16 +901,16 @@ class block_pool {
   friend const_iterator;
   
   typedef typename block_type::ptr block_ptr;
-  typedef typename std::allocator_traits<allocator>::template rebind_alloc<block_type> proxy_allocator;
+  typedef typename std::allocator_traits<block_allocator>::template rebind_alloc<block_type> proxy_allocator;
   typedef typename std::allocator_traits<allocator>::template rebind_alloc<block_ptr> block_ptr_allocator;
   typedef std::vector<block_ptr, block_ptr_allocator> blocks_t;
 
   const blocks_t& get_blocks() const { return rep_.first(); }
   blocks_t& get_blocks() { return rep_.first(); }
-  const allocator& get_allocator() const { return rep_.second(); }
-  allocator& get_allocator() { return rep_.second(); }
+  const block_allocator& get_block_allocator() const { return rep_.second(); }
+  block_allocator& get_block_allocator() { return rep_.second(); }
 
-  compact_pair<blocks_t, allocator> rep_;
+  compact_pair<blocks_t, block_allocator> rep_;
 }; // block_pool
 
 NS_END
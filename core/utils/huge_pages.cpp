@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "huge_pages.hpp"
+#include "log.hpp"
+#include "mmap_utils.hpp"
+#include "thread_utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <new>
+
+NS_LOCAL
+
+const size_t ALIGNMENT = 64; // cache line size, sufficient for any type
+
+std::atomic<irs::memory::huge_pages_mode> MODE(
+  irs::memory::huge_pages_mode::NONE
+);
+
+inline size_t align_up(size_t value, size_t alignment) NOEXCEPT {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief map a huge page aligned anonymous region of the specified size
+///        (a multiple of HUGE_PAGE_SIZE)
+/// @throws std::bad_alloc
+////////////////////////////////////////////////////////////////////////////////
+void* map_chunk(size_t size) {
+  using irs::memory::HUGE_PAGE_SIZE;
+
+  #ifdef MAP_HUGETLB
+    if (irs::memory::huge_pages_mode::EXPLICIT == MODE.load()) {
+      auto* addr = mmap(
+        nullptr, size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANON | MAP_HUGETLB, -1, 0
+      );
+
+      if (MAP_FAILED != addr) {
+        return addr;
+      }
+
+      IR_FRMT_DEBUG(
+        "Failed to map reserved huge pages, error: %d, falling back to transparent huge pages",
+        errno
+      );
+    }
+  #endif
+
+  #ifdef _MSC_VER
+    // partial unmapping is not supported, rely on allocation granularity
+    auto* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+
+    if (MAP_FAILED == addr) {
+      throw std::bad_alloc();
+    }
+  #else
+    // over-allocate to align the chunk on a huge page boundary
+    auto* mapped = static_cast<irs::byte_type*>(mmap(
+      nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANON, -1, 0
+    ));
+
+    if (MAP_FAILED == static_cast<void*>(mapped)) {
+      throw std::bad_alloc();
+    }
+
+    auto* addr = reinterpret_cast<irs::byte_type*>(
+      align_up(reinterpret_cast<uintptr_t>(mapped), HUGE_PAGE_SIZE)
+    );
+
+    if (addr != mapped) {
+      munmap(mapped, addr - mapped);
+    }
+
+    munmap(addr + size, mapped + HUGE_PAGE_SIZE - addr);
+  #endif
+
+  irs::memory::advise_huge_pages(addr, size);
+
+  return addr;
+}
+
+NS_END
+
+NS_ROOT
+NS_BEGIN(memory)
+
+huge_pages_mode huge_pages() NOEXCEPT {
+  return MODE.load();
+}
+
+void huge_pages(huge_pages_mode mode) NOEXCEPT {
+  MODE.store(mode);
+}
+
+bool advise_huge_pages(void* addr, size_t size) NOEXCEPT {
+  #ifdef MADV_HUGEPAGE
+    const auto begin = align_up(reinterpret_cast<uintptr_t>(addr), HUGE_PAGE_SIZE);
+    const auto end = (reinterpret_cast<uintptr_t>(addr) + size) & ~(HUGE_PAGE_SIZE - 1);
+
+    if (begin >= end) {
+      return false; // region does not span a huge page
+    }
+
+    return 0 == ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+  #else
+    UNUSED(addr);
+    UNUSED(size);
+
+    return false;
+  #endif
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                    huge_page_arena implementation
+// -----------------------------------------------------------------------------
+
+huge_page_arena::~huge_page_arena() {
+  for (auto& entry : chunks_) {
+    munmap(entry.first, entry.second.size);
+  }
+}
+
+void* huge_page_arena::allocate(size_t size) {
+  size = align_up((std::max)(size, size_t(1)), ALIGNMENT);
+
+  SCOPED_LOCK(lock_);
+
+  // reuse a released allocation of the same size
+  auto it = free_.find(size);
+
+  if (it != free_.end() && !it->second.empty()) {
+    auto* addr = static_cast<byte_type*>(it->second.back());
+    auto chunk = chunks_.upper_bound(addr);
+
+    assert(chunk != chunks_.begin());
+    ++(--chunk)->second.allocated;
+    it->second.pop_back();
+
+    return addr;
+  }
+
+  if (size_t(end_ - next_) < size) {
+    const auto chunk_size = align_up(size, HUGE_PAGE_SIZE);
+    auto* addr = static_cast<byte_type*>(map_chunk(chunk_size));
+    chunks_t::iterator entry;
+
+    try {
+      entry = chunks_.emplace(addr, chunk(chunk_size)).first;
+    } catch (...) {
+      munmap(addr, chunk_size);
+
+      throw;
+    }
+
+    auto prev = current_;
+
+    // the remainder of the previous chunk is not used
+    current_ = entry;
+    next_ = addr;
+    end_ = addr + chunk_size;
+
+    if (prev != chunks_.end() && !prev->second.allocated) {
+      release(prev);
+    }
+  }
+
+  auto* addr = next_;
+
+  next_ += size;
+  ++current_->second.allocated;
+
+  return addr;
+}
+
+void huge_page_arena::deallocate(void* addr, size_t size) NOEXCEPT {
+  if (!addr) {
+    return;
+  }
+
+  size = align_up((std::max)(size, size_t(1)), ALIGNMENT);
+
+  SCOPED_LOCK(lock_);
+
+  auto chunk = chunks_.upper_bound(static_cast<byte_type*>(addr));
+
+  assert(chunk != chunks_.begin());
+  --chunk;
+  assert(chunk->second.allocated);
+
+  if (!--chunk->second.allocated) {
+    release(chunk);
+
+    return;
+  }
+
+  try {
+    free_[size].emplace_back(addr);
+  } catch (...) {
+    IR_LOG_EXCEPTION(); // allocation is lost until its chunk is released
+  }
+}
+
+size_t huge_page_arena::chunks() const NOEXCEPT {
+  SCOPED_LOCK(lock_);
+  return chunks_.size();
+}
+
+void huge_page_arena::release(chunks_t::iterator chunk) NOEXCEPT {
+  auto* begin = chunk->first;
+  auto* end = begin + chunk->second.size;
+
+  // drop released allocations of the chunk
+  for (auto& entry : free_) {
+    auto& addrs = entry.second;
+
+    addrs.erase(
+      std::remove_if(
+        addrs.begin(), addrs.end(),
+        [begin, end](void* addr) NOEXCEPT {
+          return addr >= begin && addr < end;
+      }),
+      addrs.end()
+    );
+  }
+
+  if (chunk == current_) {
+    next_ = begin; // reuse the whole chunk for new allocations
+  } else {
+    munmap(begin, chunk->second.size);
+    chunks_.erase(chunk);
+  }
+}
+
+NS_END // memory
+NS_END // ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_HUGE_PAGES_H
+#define IRESEARCH_HUGE_PAGES_H
+
+#include "shared.hpp"
+#include "noncopyable.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+NS_ROOT
+NS_BEGIN(memory)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief size of a huge page on x86_64 and ARMv8 (with 4 KB base pages)
+////////////////////////////////////////////////////////////////////////////////
+const size_t HUGE_PAGE_SIZE = size_t(1) << 21;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief huge page usage of block pools and memory_allocator buffers
+////////////////////////////////////////////////////////////////////////////////
+enum class huge_pages_mode {
+  NONE, // regular pages
+  TRANSPARENT, // request transparent huge pages via madvise(MADV_HUGEPAGE)
+  EXPLICIT // use reserved huge pages via MAP_HUGETLB, fall back to TRANSPARENT
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @return process-wide huge page mode, NONE by default
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API huge_pages_mode huge_pages() NOEXCEPT;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set process-wide huge page mode, affects allocators created after
+///        the call, e.g. block pools of newly created segment writers
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void huge_pages(huge_pages_mode mode) NOEXCEPT;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief request transparent huge pages for the largest huge page aligned
+///        part of the specified region (if any)
+/// @return success, false if the region spans no huge page or the platform
+///         does not support transparent huge pages
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API bool advise_huge_pages(void* addr, size_t size) NOEXCEPT;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class huge_page_arena
+/// @brief carves allocations out of huge page backed chunks, released
+///        allocations are kept for reuse by allocations of the same size,
+///        i.e. suitable for fixed size blocks, a chunk is returned to the
+///        system as soon as all of its allocations are released
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API huge_page_arena : private util::noncopyable {
+ public:
+  huge_page_arena() = default;
+  ~huge_page_arena();
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @throws std::bad_alloc
+  ////////////////////////////////////////////////////////////////////////////
+  void* allocate(size_t size);
+  void deallocate(void* addr, size_t size) NOEXCEPT;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @return number of currently mapped chunks
+  ////////////////////////////////////////////////////////////////////////////
+  size_t chunks() const NOEXCEPT;
+
+ private:
+  struct chunk {
+    explicit chunk(size_t size) NOEXCEPT : size(size) { }
+
+    size_t size; // size of the mapped region
+    size_t allocated{}; // number of live allocations
+  };
+
+  typedef std::map<byte_type*, chunk> chunks_t; // by chunk address
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief drop released allocations of a chunk without live allocations,
+  ///        unmap the chunk unless it is the current one
+  ////////////////////////////////////////////////////////////////////////////
+  void release(chunks_t::iterator chunk) NOEXCEPT;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  chunks_t chunks_; // mapped regions
+  chunks_t::iterator current_{ chunks_.end() }; // chunk used for new allocations
+  byte_type* end_{}; // end of the current chunk
+  std::unordered_map<size_t, std::vector<void*>> free_; // by allocation size
+  mutable std::mutex lock_;
+  byte_type* next_{}; // next unused byte of the current chunk
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // huge_page_arena
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class huge_page_allocator
+/// @brief std-compatible allocator using a huge_page_arena if huge pages
+///        were enabled at construction time, std::allocator otherwise,
+///        every default constructed allocator gets its own arena which is
+///        shared by its copies (including rebound ones)
+////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+class huge_page_allocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template<typename U>
+  struct rebind {
+    typedef huge_page_allocator<U> other;
+  };
+
+  huge_page_allocator()
+    : arena_(huge_pages_mode::NONE == huge_pages()
+        ? nullptr
+        : std::make_shared<huge_page_arena>()) {
+  }
+
+  template<typename U>
+  huge_page_allocator(const huge_page_allocator<U>& rhs) NOEXCEPT
+    : arena_(rhs.arena()) {
+  }
+
+  pointer allocate(size_type n) {
+    return arena_
+      ? static_cast<pointer>(arena_->allocate(n * sizeof(T)))
+      : std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(pointer p, size_type n) NOEXCEPT {
+    if (arena_) {
+      arena_->deallocate(p, n * sizeof(T));
+    } else {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  const std::shared_ptr<huge_page_arena>& arena() const NOEXCEPT {
+    return arena_;
+  }
+
+  bool huge() const NOEXCEPT { return nullptr != arena_; }
+
+  template<typename U>
+  bool operator==(const huge_page_allocator<U>& rhs) const NOEXCEPT {
+    return arena_ == rhs.arena();
+  }
+
+  template<typename U>
+  bool operator!=(const huge_page_allocator<U>& rhs) const NOEXCEPT {
+    return !(*this == rhs);
+  }
+
+ private:
+  std::shared_ptr<huge_page_arena> arena_; // nullptr for regular pages
+}; // huge_page_allocator
+
+NS_END // memory
+NS_END // ROOT
+
+#endif // IRESEARCH_HUGE_PAGES_H
@@ -23,8 +23,11 @@
 
 #include "formats/format_utils.hpp"
 #include "index_utils.hpp"
+#include "store/compound_directory.hpp"
 
 #include <cmath>
+#include <mutex>
+#include <unordered_set>
 
 NS_LOCAL
 
@@ -176,6 +179,49 @@ double_t consolidation_score(
   return score;
 }
 
+/// @brief I/O budget shared by all invocations of a 'consolidate_cost' policy
+struct consolidation_budget {
+  std::mutex lock; // guards all of the members below
+  std::chrono::steady_clock::time_point window_start;
+  size_t merged{}; // bytes written by merges picked in the current window
+  size_t ingested{}; // bytes of new segments seen in the current window
+  size_t pending{}; // bytes of picked merges not seen in index meta yet
+  std::unordered_set<std::string> seen; // names of already accounted segments
+};
+
+/// @returns benefit/cost score of the consolidation bucket
+double_t consolidation_cost_score(
+    const consolidation_candidate& consolidation,
+    const irs::index_utils::consolidate_cost& options
+) NOEXCEPT {
+  size_t size_before_consolidation = 0;
+  size_t size_after_consolidation = 0;
+  for (auto& segment_stat : consolidation) {
+    size_before_consolidation += segment_stat.meta->size;
+    size_after_consolidation += segment_stat.size;
+  }
+
+  const auto reclaimed = size_before_consolidation - size_after_consolidation;
+
+  if (1 == consolidation.count && !reclaimed) {
+    return -1.; // singleton without removals makes no sense
+  }
+
+  auto benefit = options.segments_weight
+    * double_t(consolidation.count - 1) / options.max_segments;
+
+  if (size_before_consolidation) {
+    benefit += options.removals_weight
+      * double_t(reclaimed) / size_before_consolidation;
+  }
+
+  const auto cost = double_t(
+    std::max(size_after_consolidation, options.floor_segment_bytes)
+  ) / options.max_segments_bytes;
+
+  return benefit / cost;
+}
+
 NS_END
 
 NS_ROOT
@@ -469,6 +515,129 @@ index_writer::consolidation_policy_t consolidation_policy(
   };
 }
 
+index_writer::consolidation_policy_t consolidation_policy(
+  const consolidate_cost& options
+) {
+  // validate input
+  auto opts = options;
+  opts.max_segments = (std::max)(size_t(1), options.max_segments); // can't merge less than 1 segment
+  opts.min_segments = (std::min)((std::max)(size_t(1), options.min_segments), opts.max_segments);
+  opts.max_segments_bytes = (std::max)(size_t(1), options.max_segments_bytes);
+  opts.floor_segment_bytes = (std::max)(size_t(1), options.floor_segment_bytes);
+
+  auto budget = std::make_shared<consolidation_budget>();
+  budget->window_start = std::chrono::steady_clock::now();
+
+  return [opts, budget](
+      std::set<const segment_meta*>& candidates,
+      const index_meta& meta,
+      const index_writer::consolidating_segments_t& consolidating_segments
+  )->void {
+    // the policy may be shared by multiple writers
+    SCOPED_LOCK(budget->lock);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Stage 0
+    /// get sorted list of segments available for consolidation
+    ///////////////////////////////////////////////////////////////////////////
+
+    std::set<segment_stat> sorted_segments;
+    std::unordered_set<std::string> seen;
+    size_t new_bytes = 0; // bytes of segments not seen by previous invocations
+
+    meta.visit_segments([&](
+        const std::string& /*filename*/,
+        const irs::segment_meta& segment
+    ) {
+      if (!budget->seen.count(segment.name)) {
+        new_bytes += segment.size;
+      }
+
+      seen.emplace(segment.name);
+
+      if (consolidating_segments.end() == consolidating_segments.find(&segment)) {
+        sorted_segments.insert(segment);
+      }
+
+      return true;
+    });
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Stage 1
+    /// account newly seen segments, outputs of picked merges are not counted
+    /// as ingested bytes
+    ///////////////////////////////////////////////////////////////////////////
+
+    const auto now = std::chrono::steady_clock::now();
+
+    if (now - budget->window_start >= opts.window) {
+      budget->window_start = now;
+      budget->merged = 0;
+      budget->ingested = 0;
+    }
+
+    const auto merge_outputs = std::min(new_bytes, budget->pending);
+    budget->pending -= merge_outputs;
+    budget->ingested += new_bytes - merge_outputs;
+    budget->seen = std::move(seen); // forget removed segments
+
+    auto fits_budget = [&opts, &budget](size_t bytes) NOEXCEPT {
+      const auto merged = budget->merged + bytes;
+
+      return (!opts.window_bytes || merged <= opts.window_bytes)
+        && (!opts.max_write_amplification
+            || merged <= opts.max_write_amplification * budget->ingested);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Stage 2
+    /// find the best candidate among runs of segments adjacent in size
+    ///////////////////////////////////////////////////////////////////////////
+
+    consolidation_candidate best;
+
+    for (auto i = sorted_segments.begin(), end = sorted_segments.end(); i != end; ++i) {
+      consolidation_candidate candidate(i);
+
+      while (candidate.segments.second != end
+             && candidate.count < opts.max_segments
+             && candidate.size + candidate.segments.second->size <= opts.max_segments_bytes) {
+        candidate.size += candidate.segments.second->size;
+        ++candidate.count;
+        ++candidate.segments.second;
+
+        if (candidate.count < opts.min_segments) {
+          continue;
+        }
+
+        candidate.score = ::consolidation_cost_score(candidate, opts);
+
+        if (candidate.score >= opts.min_score
+            && best.score < candidate.score
+            && fits_budget(candidate.size)) {
+          best = candidate;
+        }
+      }
+    }
+
+    if (!best.count) {
+      return; // nothing worth its cost
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Stage 3
+    /// charge the budget and pick the best candidate
+    ///////////////////////////////////////////////////////////////////////////
+
+    budget->merged += best.size;
+    budget->pending += best.size;
+
+    for (auto& segment : best) {
+      candidates.insert(segment.meta);
+    }
+  };
+}
+
 void read_document_mask(
   iresearch::document_mask& docs_mask,
   const iresearch::directory& dir,
@@ -504,6 +673,67 @@ void write_index_segment(directory& dir, index_meta::index_segment_t& segment) {
   writer->write(dir, segment.meta);
 }
 
+bool pack_segment(directory& dir, segment_meta& meta, size_t max_size) {
+  if (!max_size || !meta.codec) {
+    return false; // packing is disabled
+  }
+
+  const auto compound_file = compound_directory::file_name(meta.name);
+
+  if (meta.files.end() != meta.files.find(compound_file)) {
+    return false; // already packed
+  }
+
+  // document mask is versioned separately from the data files
+  const auto mask_file = meta.codec->get_document_mask_writer()->filename(meta);
+  std::vector<std::string> files;
+  size_t size = 0;
+
+  files.reserve(meta.files.size());
+
+  for (auto& file : meta.files) {
+    if (file == mask_file) {
+      continue;
+    }
+
+    uint64_t length;
+
+    if (!dir.length(length, file)) {
+      IR_FRMT_WARN("Failed to get length of the file '%s'", file.c_str());
+      return false;
+    }
+
+    size += length;
+
+    if (size > max_size) {
+      return false; // segment is too big
+    }
+
+    files.emplace_back(file);
+  }
+
+  if (files.size() < 2) {
+    return false; // nothing to gain
+  }
+
+  if (!compound_directory::write(dir, meta.name, files)) {
+    dir.remove(compound_file); // remove partially written file (if any)
+    return false;
+  }
+
+  for (auto& file : files) {
+    meta.files.erase(file);
+
+    if (!dir.remove(file)) {
+      IR_FRMT_WARN("Failed to remove packed file '%s'", file.c_str());
+    }
+  }
+
+  meta.files.emplace(compound_file);
+
+  return true;
+}
+
 NS_END // index_utils
 NS_END // NS_ROOT
 
@@ -26,6 +26,8 @@
 
 #include "index/index_writer.hpp"
 
+#include <chrono>
+
 NS_ROOT
 NS_BEGIN(index_utils)
 
@@ -83,6 +85,40 @@ struct consolidate_tier {
   size_t lookahead = integer_traits<size_t>::const_max;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cost based consolidation: candidate merges of segments adjacent in
+///        size are scored as benefit / cost, where
+///          benefit = removals_weight * (reclaimed bytes / candidate bytes)
+///                  + segments_weight * (#candidate segments - 1) / max_segments
+///          cost    = max(bytes written, floor_segment_bytes) / max_segments_bytes
+///        the best candidate with score >= min_score that fits the budget is
+///        picked, budgets are tracked by the policy instance across calls
+/// @param min_segments minimum allowed number of segments to consolidate at once
+/// @param max_segments maximum allowed number of segments to consolidate at once
+/// @param max_segments_bytes maxinum allowed size of all consolidated segments
+/// @param floor_segment_bytes treat all smaller merges as equally cheap
+/// @param removals_weight weight of reclaimable removed documents in a benefit
+/// @param segments_weight weight of segment count (i.e. query cost) reduction
+/// @param min_score minimum score of a merge worth its cost
+/// @param window duration of a budget window
+/// @param window_bytes maximum number of bytes written by merges per window
+///        0 == unlimited
+/// @param max_write_amplification maximum ratio of bytes written by merges to
+///        bytes of newly seen segments per window, 0 == unlimited
+////////////////////////////////////////////////////////////////////////////////
+struct consolidate_cost {
+  size_t min_segments = 1;
+  size_t max_segments = 10;
+  size_t max_segments_bytes = size_t(5)*(1<<30);
+  size_t floor_segment_bytes = size_t(2)*(1<<20);
+  double_t removals_weight = 1.;
+  double_t segments_weight = 1.;
+  double_t min_score = 0.5;
+  std::chrono::milliseconds window = std::chrono::seconds(60);
+  size_t window_bytes = 0;
+  double_t max_write_amplification = 0.;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @return a consolidation policy with the specified options
 ////////////////////////////////////////////////////////////////////////////////
@@ -125,6 +161,13 @@ IRESEARCH_API index_writer::consolidation_policy_t consolidation_policy(
   const consolidate_tier& options
 );
 
+////////////////////////////////////////////////////////////////////////////////
+/// @return a consolidation policy with the specified options
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API index_writer::consolidation_policy_t consolidation_policy(
+  const consolidate_cost& options
+);
+
 void read_document_mask(document_mask& docs_mask, const directory& dir, const segment_meta& meta);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -134,6 +177,15 @@ void read_document_mask(document_mask& docs_mask, const directory& dir, const se
 ////////////////////////////////////////////////////////////////////////////////
 void write_index_segment(directory& dir, index_meta::index_segment_t& segment);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief packs files of the segment, except for the document mask, into a
+///        single compound file if their total size does not exceed 'max_size'
+///        updates segment_meta::files, packed files are removed
+/// @param max_size 0 == never pack
+/// @return true if files of the segment were packed
+////////////////////////////////////////////////////////////////////////////////
+bool pack_segment(directory& dir, segment_meta& meta, size_t max_size);
+
 NS_END
 NS_END
 
@@ -40,6 +40,7 @@
 #define IR_MADVICE_WILLNEED 0
 #define IR_MADVICE_DONTNEED 0
 #define IR_MADVICE_DONTDUMP 0
+#define IR_MADVICE_HUGEPAGE 0
 
 #else
 
@@ -77,6 +78,11 @@
 #define IR_MADVICE_RANDOM MADV_RANDOM
 #define IR_MADVICE_WILLNEED MADV_WILLNEED
 #define IR_MADVICE_DONTNEED MADV_DONTNEED
+#ifdef MADV_HUGEPAGE
+#define IR_MADVICE_HUGEPAGE MADV_HUGEPAGE
+#else
+#define IR_MADVICE_HUGEPAGE 0
+#endif
 
 #endif // _MSC_VER
 
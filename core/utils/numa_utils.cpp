@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "numa_utils.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#ifdef __linux__
+  #include <fstream>
+  #include <string>
+
+  #include <pthread.h>
+  #include <sched.h>
+#endif // __linux__
+
+NS_LOCAL
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief NUMA topology of the host, loaded once
+/// @note nodes without CPUs are skipped and the remaining nodes are indexed
+///       densely, i.e. system node ids '0,2' become nodes '0,1'
+////////////////////////////////////////////////////////////////////////////////
+struct topology {
+  std::vector<size_t> cpu_nodes; // node by CPU
+  std::vector<std::vector<size_t>> node_cpus; // CPUs by node
+
+  static const topology& instance() {
+    static const topology INSTANCE;
+    return INSTANCE;
+  }
+
+ private:
+  topology() {
+    #ifdef __linux__
+      // node ids may be sparse, e.g. '0,2-3'
+      std::ifstream online("/sys/devices/system/node/online");
+
+      if (!online) {
+        return;
+      }
+
+      std::string ids;
+      std::getline(online, ids);
+
+      for (auto id : parse_cpulist(ids)) {
+        std::ifstream in(
+          "/sys/devices/system/node/node" + std::to_string(id) + "/cpulist"
+        );
+
+        if (!in) {
+          continue;
+        }
+
+        std::string cpulist;
+        std::getline(in, cpulist);
+
+        auto cpus = parse_cpulist(cpulist);
+
+        if (cpus.empty()) {
+          continue; // memory-only node
+        }
+
+        const auto node = node_cpus.size();
+
+        for (auto cpu : cpus) {
+          if (cpu >= cpu_nodes.size()) {
+            cpu_nodes.resize(cpu + 1, 0);
+          }
+
+          cpu_nodes[cpu] = node;
+        }
+
+        node_cpus.emplace_back(std::move(cpus));
+      }
+    #endif // __linux__
+  }
+
+  // parse a list of CPU (or node) ranges, e.g. '0-3,8-11'
+  static std::vector<size_t> parse_cpulist(const std::string& cpulist) {
+    std::vector<size_t> cpus;
+    const char* begin = cpulist.c_str();
+
+    while (*begin) {
+      char* end;
+      const size_t first = strtoul(begin, &end, 10);
+      size_t last = first;
+
+      if (end == begin) {
+        break; // malformed or empty list
+      }
+
+      if ('-' == *end) {
+        begin = end + 1;
+        last = strtoul(begin, &end, 10);
+      }
+
+      for (auto cpu = first; cpu <= last; ++cpu) {
+        cpus.emplace_back(cpu);
+      }
+
+      begin = ',' == *end ? end + 1 : end;
+    }
+
+    return cpus;
+  }
+}; // topology
+
+NS_END
+
+NS_ROOT
+NS_BEGIN(numa_utils)
+
+size_t nodes() NOEXCEPT {
+  try {
+    return (std::max)(topology::instance().node_cpus.size(), size_t(1));
+  } catch (...) {
+    IR_LOG_EXCEPTION();
+  }
+
+  return 1;
+}
+
+size_t current_node() NOEXCEPT {
+  #ifdef __linux__
+    try {
+      auto& nodes = topology::instance().cpu_nodes;
+      const auto cpu = sched_getcpu();
+
+      return cpu >= 0 && size_t(cpu) < nodes.size() ? nodes[cpu] : 0;
+    } catch (...) {
+      IR_LOG_EXCEPTION();
+    }
+  #endif // __linux__
+
+  return 0;
+}
+
+bool bind_current_thread(size_t node) NOEXCEPT {
+  try {
+    auto& nodes = topology::instance().node_cpus;
+
+    if (nodes.empty()) {
+      return 0 == node; // unknown topology, i.e. a single node
+    }
+
+    if (node >= nodes.size()) {
+      return false;
+    }
+
+    #ifdef __linux__
+      cpu_set_t set;
+
+      CPU_ZERO(&set);
+
+      for (auto cpu : nodes[node]) {
+        if (cpu < CPU_SETSIZE) {
+          CPU_SET(cpu, &set);
+        }
+      }
+
+      if (pthread_setaffinity_np(pthread_self(), sizeof set, &set)) {
+        IR_FRMT_WARN(
+          "Failed to bind thread to NUMA node '" IR_SIZE_T_SPECIFIER "'", node
+        );
+
+        return false;
+      }
+
+      return true;
+    #endif // __linux__
+  } catch (...) {
+    IR_LOG_EXCEPTION();
+  }
+
+  return false;
+}
+
+NS_END // numa_utils
+NS_END // ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
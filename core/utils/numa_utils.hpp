@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_NUMA_UTILS_H
+#define IRESEARCH_NUMA_UTILS_H
+
+#include "shared.hpp"
+
+NS_ROOT
+NS_BEGIN(numa_utils)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @return number of NUMA nodes of the host, 1 if the topology is unknown
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API size_t nodes() NOEXCEPT;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @return NUMA node of the CPU executing the current thread,
+///         0 if the topology is unknown
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API size_t current_node() NOEXCEPT;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restrict the current thread to the CPUs of the specified NUMA node,
+///        memory first touched by the thread is then allocated on that node
+///        (default policy of the Linux kernel)
+/// @return success, a NOOP returning true on hosts with an unknown topology
+///         and node 0
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API bool bind_current_thread(size_t node) NOEXCEPT;
+
+NS_END // numa_utils
+NS_END // ROOT
+
+#endif // IRESEARCH_NUMA_UTILS_H
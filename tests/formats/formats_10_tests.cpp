@@ -33,6 +33,92 @@
 #include "formats_test_case_base.hpp"
 #include "formats/format_utils.hpp"
 
+NS_LOCAL
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class counting_input
+/// @brief tracks the number of alive inputs (including reopened and dupped)
+////////////////////////////////////////////////////////////////////////////////
+class counting_input final : public irs::index_input {
+ public:
+  counting_input(irs::index_input::ptr&& impl, size_t& count) NOEXCEPT
+    : impl_(std::move(impl)), count_(count) {
+    ++count_;
+  }
+
+  virtual ~counting_input() {
+    --count_;
+  }
+
+  virtual ptr dup() const NOEXCEPT override {
+    return wrap(impl_->dup());
+  }
+
+  virtual ptr reopen() const NOEXCEPT override {
+    return wrap(impl_->reopen());
+  }
+
+  virtual irs::byte_type read_byte() override {
+    return impl_->read_byte();
+  }
+
+  virtual size_t read_bytes(irs::byte_type* b, size_t count) override {
+    return impl_->read_bytes(b, count);
+  }
+
+  virtual size_t file_pointer() const override {
+    return impl_->file_pointer();
+  }
+
+  virtual size_t length() const override {
+    return impl_->length();
+  }
+
+  virtual bool eof() const override {
+    return impl_->eof();
+  }
+
+  virtual void seek(size_t pos) override {
+    impl_->seek(pos);
+  }
+
+  virtual int64_t checksum(size_t offset) const override {
+    return impl_->checksum(offset);
+  }
+
+ private:
+  ptr wrap(ptr&& impl) const NOEXCEPT {
+    return impl
+      ? ptr(new counting_input(std::move(impl), count_))
+      : nullptr;
+  }
+
+  irs::index_input::ptr impl_;
+  size_t& count_;
+}; // counting_input
+
+class counting_directory final : public tests::directory_mock {
+ public:
+  explicit counting_directory(irs::directory& impl)
+    : tests::directory_mock(impl) {
+  }
+
+  virtual irs::index_input::ptr open(
+      const std::string& name,
+      irs::IOAdvice advice
+  ) const NOEXCEPT override {
+    auto in = tests::directory_mock::open(name, advice);
+
+    return in
+      ? irs::index_input::ptr(new counting_input(std::move(in), inputs))
+      : nullptr;
+  }
+
+  mutable size_t inputs{}; // number of alive inputs
+}; // counting_directory
+
+NS_END
+
 class format_10_test_case : public tests::format_test_case_base {
  protected:
   const size_t VERSION10_POSTINGS_WRITER_BLOCK_SIZE = 128;
@@ -324,6 +410,139 @@ class format_10_test_case : public tests::format_test_case_base {
     }
   }
 
+  void postings_iterator_reuse(const irs::flags& features) {
+    irs::field_meta field;
+    field.features = features;
+
+    std::vector<irs::doc_id_t> docs0;
+    std::vector<irs::doc_id_t> docs1;
+    for (irs::doc_id_t i = irs::type_limits<irs::type_t::doc_id_t>::min(); i < 5000; ++i) {
+      docs0.push_back(2*i);
+      if (i % 3) {
+        docs1.push_back(2*i + 1);
+      }
+    }
+
+    auto codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
+    ASSERT_NE(nullptr, codec);
+    auto writer = codec->get_postings_writer(false);
+    ASSERT_NE(nullptr, writer);
+    irs::postings_writer::state meta0, meta1; // must be destroyed before writer
+
+    // write postings
+    {
+      irs::flush_state state;
+      state.dir = &dir();
+      state.doc_count = docs1.back() + 1;
+      state.fields_count = 1;
+      state.name = "segment_name";
+      state.ver = IRESEARCH_VERSION;
+      state.features = &field.features;
+
+      auto out = dir().create("attributes");
+      ASSERT_FALSE(!out);
+
+      writer->prepare(*out, state);
+      writer->begin_field(field.features);
+
+      {
+        postings docs(docs0.begin(), docs0.end(), field.features);
+        meta0 = writer->write(docs);
+        writer->encode(*out, *meta0);
+      }
+
+      {
+        postings docs(docs1.begin(), docs1.end(), field.features);
+        meta1 = writer->write(docs);
+        writer->encode(*out, *meta1);
+      }
+
+      writer->end();
+    }
+
+    // read postings
+    {
+      irs::segment_meta meta;
+      meta.name = "segment_name";
+
+      counting_directory reader_dir(dir());
+
+      irs::reader_state state;
+      state.dir = &reader_dir;
+      state.meta = &meta;
+
+      auto in = reader_dir.open("attributes", irs::IOAdvice::NORMAL);
+      ASSERT_FALSE(!in);
+
+      auto reader = codec->get_postings_reader();
+      ASSERT_NE(nullptr, reader);
+      reader->prepare(*in, state, field.features);
+
+      irs::frequency freq0, freq1;
+      irs::version10::term_meta read_meta0, read_meta1;
+      irs::attribute_view read_attrs0, read_attrs1;
+      read_attrs0.emplace(read_meta0);
+      read_attrs1.emplace(read_meta1);
+      if (field.features.check<irs::frequency>()) {
+        read_attrs0.emplace(freq0);
+        read_attrs1.emplace(freq1);
+      }
+
+      reader->decode(*in, field.features, read_attrs0, read_meta0);
+      read_meta1 = read_meta0; // term attributes are delta encoded
+      reader->decode(*in, field.features, read_attrs1, read_meta1);
+
+      const auto idle_inputs = reader_dir.inputs;
+
+      // partially consume postings of the first term
+      const irs::doc_iterator* released;
+      {
+        auto it = reader->iterator(field.features, read_attrs0, field.features);
+        ASSERT_EQ(docs0[3000], it->seek(docs0[3000]));
+        ASSERT_TRUE(it->next());
+        ASSERT_EQ(docs0[3001], it->value());
+        ASSERT_LT(idle_inputs, reader_dir.inputs); // reopened inputs and skip levels
+        released = it.get();
+      }
+
+      // pooled iterators don't hold any inputs
+      ASSERT_EQ(idle_inputs, reader_dir.inputs);
+
+      // released iterator is reused for the second term
+      {
+        auto it = reader->iterator(field.features, read_attrs1, field.features);
+        ASSERT_EQ(released, it.get());
+        ASSERT_FALSE(irs::type_limits<irs::type_t::doc_id_t>::valid(it->value()));
+
+        postings expected(docs1.begin(), docs1.end(), field.features);
+        for (size_t i = 0, size = docs1.size(); i < size; i += 97) {
+          ASSERT_EQ(docs1[i], it->seek(docs1[i]));
+          ASSERT_EQ(docs1[i], expected.seek(docs1[i]));
+          assert_positions(expected, *it);
+        }
+        ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it->seek(docs1.back() + 1)));
+      }
+
+      // iterators in use are never shared
+      {
+        auto it0 = reader->iterator(field.features, read_attrs0, field.features);
+        auto it1 = reader->iterator(field.features, read_attrs0, field.features);
+        ASSERT_NE(it0.get(), it1.get());
+
+        for (auto doc : docs0) {
+          ASSERT_TRUE(it0->next());
+          ASSERT_EQ(doc, it0->value());
+        }
+        ASSERT_FALSE(it0->next());
+
+        ASSERT_EQ(docs0.back(), it1->seek(docs0.back()));
+        ASSERT_FALSE(it1->next());
+      }
+
+      ASSERT_EQ(idle_inputs, reader_dir.inputs);
+    }
+  }
+
   void postings_writer_reuse() {
     auto codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
     ASSERT_NE(nullptr, codec);
@@ -527,7 +746,10 @@ class format_10_test_case : public tests::format_test_case_base {
     ASSERT_FALSE(actual_pos->next());
   }
 
-  void postings_seek(const std::vector<irs::doc_id_t>& docs, const irs::flags& features) {
+  void postings_seek(
+      const std::vector<irs::doc_id_t>& docs,
+      const irs::flags& features,
+      bool* bitmap = nullptr) { // whether the postings are stored as a bitmap
     irs::field_meta field;
     field.features = features;
 
@@ -627,6 +849,11 @@ class format_10_test_case : public tests::format_test_case_base {
           ASSERT_EQ(typed_meta.pay_start, read_meta.pay_start);
           ASSERT_EQ(typed_meta.e_single_doc, read_meta.e_single_doc);
           ASSERT_EQ(typed_meta.e_skip_start, read_meta.e_skip_start);
+          ASSERT_EQ(typed_meta.bitmap, read_meta.bitmap);
+        }
+
+        if (bitmap) {
+          *bitmap = read_meta.bitmap;
         }
 
         // seek for every document 127th document in a block
@@ -728,6 +955,51 @@ class format_10_test_case : public tests::format_test_case_base {
           }
         }
 
+        // shallow seek for every 37th document and right after it
+        {
+          const size_t inc = 37;
+          auto it = reader->iterator(field.features, read_attrs, field.features);
+          ASSERT_FALSE(irs::type_limits<irs::type_t::doc_id_t>::valid(it->value()));
+
+          auto* bounds = it->attributes().get<irs::block_bounds>().get();
+          ASSERT_EQ(
+            docs.size() > VERSION10_POSTINGS_WRITER_BLOCK_SIZE && !read_meta.bitmap,
+            nullptr != bounds
+          );
+
+          if (bounds) {
+            for (size_t i = 0, size = docs.size(); i < size; i += inc) {
+              for (auto target : { docs[i], docs[i] + 1 }) {
+                const auto prev = it->value();
+                const auto expected = std::lower_bound(docs.begin(), docs.end(), target);
+                const auto expected_doc = expected == docs.end()
+                  ? irs::type_limits<irs::type_t::doc_id_t>::eof()
+                  : *expected;
+
+                const auto candidate = bounds->shallow_seek(target);
+                ASSERT_EQ(prev, it->value()); // shallow seek doesn't move the iterator
+                ASSERT_LE(target, candidate);
+                ASSERT_LE(candidate, expected_doc);
+                ASSERT_EQ(expected_doc, it->seek(target));
+              }
+            }
+          }
+        }
+
+        // shallow seek far ahead, then seek to the nearer document
+        {
+          auto it = reader->iterator(field.features, read_attrs, field.features);
+          auto* bounds = it->attributes().get<irs::block_bounds>().get();
+
+          if (bounds) {
+            const auto near = docs[docs.size() / 4];
+            ASSERT_LE(docs.back(), bounds->shallow_seek(docs.back()));
+            ASSERT_EQ(near, it->seek(near));
+            ASSERT_TRUE(it->next());
+            ASSERT_EQ(docs[docs.size() / 4 + 1], it->value());
+          }
+        }
+
         // seek for INVALID_DOC
         {
           auto it = reader->iterator(field.features, read_attrs, irs::flags::empty_instance());
@@ -901,6 +1173,39 @@ class format_10_test_case : public tests::format_test_case_base {
       postings_seek(docs, { irs::frequency::type(), irs::position::type(), irs::payload::type() });
       postings_seek(docs, { irs::frequency::type(), irs::position::type(), irs::offset::type(), irs::payload::type() });
     }
+
+    // dense list with gaps (docs-only postings are stored as a bitmap)
+    {
+      std::vector<irs::doc_id_t> docs;
+      {
+        const size_t count = 5000;
+        docs.reserve(count);
+        auto i = (irs::type_limits<irs::type_t::doc_id_t>::min)();
+        size_t n = 0;
+        std::generate_n(std::back_inserter(docs), count,[&i, &n]() {return i += 1 + (++n % 64 ? 0 : 130);});
+      }
+      bool bitmap = false;
+      postings_seek(docs, {}, &bitmap);
+      ASSERT_TRUE(bitmap);
+      postings_seek(docs, { irs::frequency::type() }, &bitmap);
+      ASSERT_FALSE(bitmap); // bitmaps are written for docs-only fields only
+    }
+
+    // sparse list with irregular gaps
+    {
+      std::vector<irs::doc_id_t> docs;
+      {
+        const size_t count = 3000;
+        docs.reserve(count);
+        auto i = (irs::type_limits<irs::type_t::doc_id_t>::min)();
+        size_t n = 0;
+        std::generate_n(std::back_inserter(docs), count,[&i, &n]() {return i += 1 + (++n % 7)*(n % 263);});
+      }
+      postings_seek(docs, {});
+      postings_seek(docs, { irs::frequency::type() });
+      postings_seek(docs, { irs::frequency::type(), irs::position::type() });
+      postings_seek(docs, { irs::frequency::type(), irs::position::type(), irs::offset::type(), irs::payload::type() });
+    }
   }
 }; // format_10_test_case
 
@@ -932,6 +1237,13 @@ TEST_F(memory_format_10_test_case, postings_seek) {
   postings_seek();
 }
 
+TEST_F(memory_format_10_test_case, postings_iterator_reuse) {
+  postings_iterator_reuse(irs::flags::empty_instance());
+  postings_iterator_reuse({ irs::frequency::type() });
+  postings_iterator_reuse({ irs::frequency::type(), irs::position::type() });
+  postings_iterator_reuse({ irs::frequency::type(), irs::position::type(), irs::offset::type(), irs::payload::type() });
+}
+
 TEST_F(memory_format_10_test_case, segment_meta_rw) {
   segment_meta_read_write();
 }
@@ -988,6 +1300,48 @@ TEST_F(memory_format_10_test_case, reuse_postings_writer) {
   postings_writer_reuse();
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                        memory_directory + iresearch_format_10_ef
+// ----------------------------------------------------------------------------
+
+class memory_format_10_ef_test_case : public memory_format_10_test_case {
+ protected:
+  virtual irs::format::ptr get_codec() override {
+    return irs::formats::get("1_0-ef");
+  }
+};
+
+TEST_F(memory_format_10_ef_test_case, test_load) {
+  auto format = iresearch::formats::get("1_0-ef");
+
+  ASSERT_NE(nullptr, format);
+  ASSERT_NE(iresearch::formats::get("1_0"), format);
+}
+
+TEST_F(memory_format_10_ef_test_case, fields_rw) {
+  fields_read_write();
+}
+
+TEST_F(memory_format_10_ef_test_case, postings_rw) {
+  postings_read_write_single_doc();
+  postings_read_write();
+}
+
+TEST_F(memory_format_10_ef_test_case, postings_seek) {
+  postings_seek();
+}
+
+TEST_F(memory_format_10_ef_test_case, postings_iterator_reuse) {
+  postings_iterator_reuse(irs::flags::empty_instance());
+  postings_iterator_reuse({ irs::frequency::type() });
+  postings_iterator_reuse({ irs::frequency::type(), irs::position::type() });
+  postings_iterator_reuse({ irs::frequency::type(), irs::position::type(), irs::offset::type(), irs::payload::type() });
+}
+
+TEST_F(memory_format_10_ef_test_case, reuse_postings_writer) {
+  postings_writer_reuse();
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                               fs_directory + iresearch_format_10
 // ----------------------------------------------------------------------------
@@ -729,7 +729,9 @@ void assert_term(
     {
       auto& expected_attrs = expected_docs->attributes();
       auto& actual_attrs = actual_docs->attributes();
-      ASSERT_EQ(expected_attrs.features(), actual_attrs.features());
+      auto actual_features = actual_attrs.features();
+      actual_features.remove<irs::block_bounds>(); // optional, exposed by multi-block postings only
+      ASSERT_EQ(expected_attrs.features(), actual_features);
 
       auto& expected_freq = expected_attrs.get<iresearch::frequency>();
       auto& actual_freq = actual_attrs.get<iresearch::frequency>();
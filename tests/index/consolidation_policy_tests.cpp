@@ -27,6 +27,8 @@
 #include "store/memory_directory.hpp"
 #include "utils/index_utils.hpp"
 
+#include <thread>
+
 NS_LOCAL
 
 void assert_candidates(
@@ -423,6 +425,174 @@ TEST(consolidation_test_tier, test_skewed_segments) {
   }
 }
 
+TEST(consolidation_test_cost, test_prefer_removals) {
+  irs::index_utils::consolidate_cost options;
+  options.min_segments = 1;
+  options.max_segments = 1;
+  options.max_segments_bytes = 1000;
+  options.floor_segment_bytes = 1;
+  auto policy = irs::index_utils::consolidation_policy(options);
+
+  irs::index_meta meta;
+  meta.add(irs::segment_meta("0", nullptr, 10, 10, false, irs::segment_meta::file_set{}, 100));
+  meta.add(irs::segment_meta("1", nullptr, 10, 2, false, irs::segment_meta::file_set{}, 100));
+  meta.add(irs::segment_meta("2", nullptr, 10, 5, false, irs::segment_meta::file_set{}, 100));
+  irs::index_writer::consolidating_segments_t consolidating_segments;
+
+  // cheapest segment with the most removals first
+  {
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    assert_candidates(meta, {1}, candidates);
+    consolidating_segments.insert(candidates.begin(), candidates.end());
+  }
+
+  {
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    assert_candidates(meta, {2}, candidates);
+    consolidating_segments.insert(candidates.begin(), candidates.end());
+  }
+
+  // singleton without removals makes no sense
+  {
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_TRUE(candidates.empty());
+  }
+}
+
+TEST(consolidation_test_cost, test_min_score) {
+  irs::index_meta meta;
+  meta.add(irs::segment_meta("0", nullptr, 10, 10, false, irs::segment_meta::file_set{}, 400));
+  meta.add(irs::segment_meta("1", nullptr, 10, 10, false, irs::segment_meta::file_set{}, 400));
+  irs::index_writer::consolidating_segments_t consolidating_segments;
+
+  irs::index_utils::consolidate_cost options;
+  options.max_segments = 2;
+  options.max_segments_bytes = 1000;
+  options.floor_segment_bytes = 1;
+
+  // score == (1/2) / (800/1000) == 0.625
+  {
+    options.min_segments = 2;
+    options.min_score = 1.;
+    auto policy = irs::index_utils::consolidation_policy(options);
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_TRUE(candidates.empty());
+  }
+
+  {
+    options.min_score = 0.5;
+    auto policy = irs::index_utils::consolidation_policy(options);
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    assert_candidates(meta, {0, 1}, candidates);
+  }
+
+  // merge exceeding 'max_segments_bytes'
+  {
+    options.max_segments_bytes = 799;
+    options.min_score = 0.;
+    auto policy = irs::index_utils::consolidation_policy(options);
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_TRUE(candidates.empty());
+  }
+}
+
+TEST(consolidation_test_cost, test_window_bytes) {
+  irs::index_meta meta;
+  meta.add(irs::segment_meta("0", nullptr, 10, 5, false, irs::segment_meta::file_set{}, 100));
+  meta.add(irs::segment_meta("1", nullptr, 10, 5, false, irs::segment_meta::file_set{}, 100));
+  irs::index_writer::consolidating_segments_t consolidating_segments;
+
+  irs::index_utils::consolidate_cost options;
+  options.max_segments = 1;
+  options.max_segments_bytes = 1000;
+  options.floor_segment_bytes = 1;
+  options.window_bytes = 60;
+  options.window = std::chrono::hours(1);
+
+  {
+    auto policy = irs::index_utils::consolidation_policy(options);
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_EQ(1, candidates.size()); // 50 bytes written
+    consolidating_segments.insert(candidates.begin(), candidates.end());
+
+    // budget is exhausted for the rest of the window
+    candidates.clear();
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_TRUE(candidates.empty());
+  }
+
+  // budget is restored in the next window
+  {
+    consolidating_segments.clear();
+    options.window = std::chrono::milliseconds(1);
+    auto policy = irs::index_utils::consolidation_policy(options);
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_EQ(1, candidates.size());
+    consolidating_segments.insert(candidates.begin(), candidates.end());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    candidates.clear();
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_EQ(1, candidates.size());
+    ASSERT_EQ(0, consolidating_segments.count(*candidates.begin()));
+  }
+}
+
+TEST(consolidation_test_cost, test_write_amplification) {
+  irs::index_meta meta;
+  meta.add(irs::segment_meta("0", nullptr, 10, 5, false, irs::segment_meta::file_set{}, 100));
+  meta.add(irs::segment_meta("1", nullptr, 10, 5, false, irs::segment_meta::file_set{}, 100));
+  irs::index_writer::consolidating_segments_t consolidating_segments;
+
+  irs::index_utils::consolidate_cost options;
+  options.max_segments = 1;
+  options.max_segments_bytes = 1000;
+  options.floor_segment_bytes = 1;
+  options.window = std::chrono::hours(1);
+  options.max_write_amplification = 0.2; // 200 bytes ingested, 40 bytes allowed
+  auto policy = irs::index_utils::consolidation_policy(options);
+
+  {
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_TRUE(candidates.empty());
+  }
+
+  // 500 bytes ingested, 100 bytes allowed
+  meta.add(irs::segment_meta("2", nullptr, 10, 10, false, irs::segment_meta::file_set{}, 300));
+
+  {
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_EQ(1, candidates.size());
+    consolidating_segments.insert(candidates.begin(), candidates.end());
+
+    candidates.clear();
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_EQ(1, candidates.size());
+    consolidating_segments.insert(candidates.begin(), candidates.end());
+  }
+
+  // output of the picked merges is not accounted as ingested bytes
+  meta.add(irs::segment_meta("3", nullptr, 10, 10, false, irs::segment_meta::file_set{}, 100));
+  meta.add(irs::segment_meta("4", nullptr, 10, 5, false, irs::segment_meta::file_set{}, 100));
+  consolidating_segments.clear();
+
+  {
+    std::set<const irs::segment_meta*> candidates;
+    policy(candidates, meta, consolidating_segments);
+    ASSERT_TRUE(candidates.empty());
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
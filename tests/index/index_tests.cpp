@@ -23,6 +23,7 @@
 
 #include "tests_shared.hpp" 
 #include "iql/query_builder.hpp"
+#include "search/term_filter.hpp"
 #include "store/fs_directory.hpp"
 #include "store/mmap_directory.hpp"
 #include "store/memory_directory.hpp"
@@ -30,6 +31,7 @@
 
 #include "index_tests.hpp"
 
+#include <set>
 #include <thread>
 
 namespace tests {
@@ -596,7 +598,9 @@ class index_test_case_base : public tests::index_test_base {
 
               auto& actual_attrs = act_docs_itr->attributes();
               auto& expected_attrs = exp_docs_itr->attributes();
-              ASSERT_EQ(expected_attrs.features(), actual_attrs.features());
+              auto actual_features = actual_attrs.features();
+              actual_features.remove<irs::block_bounds>(); // optional, exposed by multi-block postings only
+              ASSERT_EQ(expected_attrs.features(), actual_features);
 
               auto& actual_freq = actual_attrs.get<irs::frequency>();
               auto& expected_freq = expected_attrs.get<irs::frequency>();
@@ -13593,6 +13597,95 @@ TEST_F(memory_index_test, doc_removal) {
       ASSERT_FALSE(docsItr->next());
     }
   }
+
+  // new segment: batched term removals (committed + in-flight segments)
+  {
+    auto make_term_filter = [](const irs::string_ref& field, const irs::string_ref& term) {
+      auto filter = irs::by_term::make();
+      static_cast<irs::by_term&>(*filter).field(field).term(term);
+      return filter;
+    };
+    auto writer = open_writer(irs::OM_CREATE);
+
+    ASSERT_TRUE(insert(*writer, doc1->indexed.begin(), doc1->indexed.end(), doc1->stored.begin(), doc1->stored.end()));
+    ASSERT_TRUE(insert(*writer, doc2->indexed.begin(), doc2->indexed.end(), doc2->stored.begin(), doc2->stored.end()));
+    ASSERT_TRUE(insert(*writer, doc3->indexed.begin(), doc3->indexed.end(), doc3->stored.begin(), doc3->stored.end()));
+    ASSERT_TRUE(insert(*writer, doc4->indexed.begin(), doc4->indexed.end(), doc4->stored.begin(), doc4->stored.end()));
+    ASSERT_TRUE(insert(*writer, doc5->indexed.begin(), doc5->indexed.end(), doc5->stored.begin(), doc5->stored.end()));
+    ASSERT_TRUE(insert(*writer, doc6->indexed.begin(), doc6->indexed.end(), doc6->stored.begin(), doc6->stored.end()));
+    writer->commit();
+
+    ASSERT_TRUE(insert(*writer, doc7->indexed.begin(), doc7->indexed.end(), doc7->stored.begin(), doc7->stored.end()));
+    writer->documents().remove(make_term_filter("name", "A"));
+    writer->documents().remove(make_term_filter("duplicated", "vczc")); // doc2 + doc3
+    writer->documents().remove(make_term_filter("name", "A")); // duplicate term
+    writer->documents().remove(make_term_filter("name", "Z")); // missing term
+    writer->documents().remove(make_term_filter("missing", "A")); // missing field
+    writer->documents().remove(make_term_filter("name", "G")); // in-flight segment
+    writer->documents().remove(make_term_filter("name", "H")); // inserted after removal
+    ASSERT_TRUE(insert(*writer, doc8->indexed.begin(), doc8->indexed.end(), doc8->stored.begin(), doc8->stored.end()));
+    writer->commit();
+
+    std::set<std::string> expected{ "D", "E", "F", "H" };
+    std::set<std::string> actual;
+    auto reader = iresearch::directory_reader::open(dir(), codec());
+
+    for (auto& segment : reader) {
+      const auto* column = segment.column_reader("name");
+      ASSERT_NE(nullptr, column);
+      auto values = column->values();
+      auto docsItr = segment.docs_iterator();
+
+      while (docsItr->next()) {
+        ASSERT_TRUE(values(docsItr->value(), actual_value));
+        actual.emplace(irs::to_string<irs::string_ref>(actual_value.c_str()));
+      }
+    }
+
+    ASSERT_EQ(expected, actual);
+  }
+
+  // existing segments: removals/updates evaluated on a flush pool
+  {
+    auto make_term_filter = [](const irs::string_ref& field, const irs::string_ref& term) {
+      auto filter = irs::by_term::make();
+      static_cast<irs::by_term&>(*filter).field(field).term(term);
+      return filter;
+    };
+    irs::index_writer::options options;
+    options.flush_pool_size = 4;
+    auto writer = open_writer(irs::OM_CREATE, options);
+
+    for (auto* doc : { doc1, doc2, doc3, doc4, doc5, doc6 }) {
+      ASSERT_TRUE(insert(*writer, doc->indexed.begin(), doc->indexed.end(), doc->stored.begin(), doc->stored.end()));
+      writer->commit(); // segment per document
+    }
+
+    writer->documents().remove(make_term_filter("name", "A"));
+    writer->documents().remove(make_term_filter("duplicated", "vczc")); // doc2 + doc3
+    ASSERT_TRUE(update(*writer, make_term_filter("name", "E"), doc7->indexed.begin(), doc7->indexed.end(), doc7->stored.begin(), doc7->stored.end()));
+    ASSERT_TRUE(update(*writer, make_term_filter("name", "Z"), doc8->indexed.begin(), doc8->indexed.end(), doc8->stored.begin(), doc8->stored.end())); // not seen
+    writer->commit();
+
+    std::set<std::string> expected{ "D", "F", "G" };
+    std::set<std::string> actual;
+    auto reader = iresearch::directory_reader::open(dir(), codec());
+    ASSERT_EQ(3, reader.size()); // fully masked segments are dropped
+
+    for (auto& segment : reader) {
+      const auto* column = segment.column_reader("name");
+      ASSERT_NE(nullptr, column);
+      auto values = column->values();
+      auto docsItr = segment.docs_iterator();
+
+      while (docsItr->next()) {
+        ASSERT_TRUE(values(docsItr->value(), actual_value));
+        actual.emplace(irs::to_string<irs::string_ref>(actual_value.c_str()));
+      }
+    }
+
+    ASSERT_EQ(expected, actual);
+  }
 }
 
 TEST_F(memory_index_test, doc_update) {
@@ -14376,6 +14469,235 @@ TEST_F(memory_index_test, doc_update) {
   }
 }
 
+TEST_F(memory_index_test, commit_async) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory
+  );
+  tests::document const* doc1 = gen.next();
+  tests::document const* doc2 = gen.next();
+  tests::document const* doc3 = gen.next();
+  tests::document const* doc4 = gen.next();
+  tests::document const* doc5 = gen.next();
+
+  irs::index_writer::options options;
+  options.flush_pool_size = 2;
+  auto writer = open_writer(irs::OM_CREATE, options);
+
+  {
+    // segments of released contexts are flushed by the next commit,
+    // 'ctx1' is held across the commit and belongs to the next one
+    auto ctx1 = writer->documents();
+    ASSERT_TRUE(ctx1.insert().insert(irs::action::index, doc1->indexed.begin(), doc1->indexed.end()));
+
+    // two concurrently held segments
+    {
+      auto ctx2 = writer->documents();
+      auto ctx3 = writer->documents();
+
+      ASSERT_TRUE(ctx2.insert().insert(irs::action::index, doc2->indexed.begin(), doc2->indexed.end()));
+      ASSERT_TRUE(ctx3.insert().insert(irs::action::index, doc3->indexed.begin(), doc3->indexed.end()));
+    }
+
+    ASSERT_EQ(2, writer->buffered_docs());
+
+    auto commit = writer->commit_async();
+
+    // wait for the flush context switch
+    while (writer->buffered_docs()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // ingestion continues while commit is in progress
+    ASSERT_TRUE(ctx1.insert().insert(irs::action::index, doc4->indexed.begin(), doc4->indexed.end()));
+    ASSERT_NO_THROW(commit.get());
+
+    auto reader = irs::directory_reader::open(dir(), codec());
+    ASSERT_EQ(2, reader.docs_count());
+    ASSERT_EQ(2, reader.live_docs_count());
+  }
+
+  writer->commit_async().get();
+
+  {
+    auto reader = irs::directory_reader::open(dir(), codec());
+    ASSERT_EQ(4, reader.docs_count());
+    ASSERT_EQ(4, reader.live_docs_count());
+  }
+
+  ASSERT_TRUE(insert(*writer, doc5->indexed.begin(), doc5->indexed.end()));
+  writer->commit_async(); // discarded result doesn't wait for the commit
+  writer->commit_async().get(); // commits are run in order of submission
+
+  {
+    auto reader = irs::directory_reader::open(dir(), codec());
+    ASSERT_EQ(5, reader.docs_count());
+    ASSERT_EQ(5, reader.live_docs_count());
+  }
+
+  writer->commit_async().get(); // nothing to commit is not an error
+  writer->close(); // waits for pending commits
+
+  ASSERT_THROW(writer->commit_async(), irs::illegal_state);
+}
+
+TEST_F(memory_index_test, import_parallel) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory
+  );
+  tests::document const* doc1 = gen.next();
+  tests::document const* doc2 = gen.next();
+  tests::document const* doc3 = gen.next();
+  tests::document const* doc4 = gen.next();
+  auto query_doc1 = irs::iql::query_builder().build("name==A", std::locale::classic());
+
+  auto count = [](const irs::index_reader& reader, const std::string& query)->size_t {
+    auto filter = irs::iql::query_builder().build(query, std::locale::classic()).filter;
+    auto prepared = filter->prepare(reader);
+    size_t count = 0;
+
+    for (auto& segment : reader) {
+      for (auto docs = segment.mask(prepared->execute(segment)); docs->next();) {
+        ++count;
+      }
+    }
+
+    return count;
+  };
+
+  // 3 segments, the first one with a removal
+  irs::memory_directory data_dir;
+  {
+    auto data_writer = irs::index_writer::make(data_dir, codec(), irs::OM_CREATE);
+    ASSERT_TRUE(insert(*data_writer, doc1->indexed.begin(), doc1->indexed.end()));
+    ASSERT_TRUE(insert(*data_writer, doc2->indexed.begin(), doc2->indexed.end()));
+    data_writer->commit();
+    data_writer->documents().remove(std::move(query_doc1.filter));
+    data_writer->commit();
+    ASSERT_TRUE(insert(*data_writer, doc3->indexed.begin(), doc3->indexed.end()));
+    data_writer->commit();
+    ASSERT_TRUE(insert(*data_writer, doc4->indexed.begin(), doc4->indexed.end()));
+    data_writer->commit();
+  }
+
+  auto data_reader = irs::directory_reader::open(data_dir, codec());
+  ASSERT_EQ(3, data_reader.size());
+
+  irs::index_writer::options options;
+  options.flush_pool_size = 2;
+  auto writer = open_writer(irs::OM_CREATE, options);
+
+  // merge groups of segments concurrently
+  {
+    irs::index_writer::import_options opts;
+    opts.segments_per_group = 2;
+    ASSERT_TRUE(writer->import(data_reader, opts));
+    writer->commit();
+
+    auto reader = irs::directory_reader::open(dir(), codec());
+    ASSERT_EQ(2, reader.size());
+    ASSERT_EQ(3, reader.docs_count());
+    ASSERT_EQ(3, reader.live_docs_count());
+    ASSERT_EQ(0, count(reader, "name==A"));
+    ASSERT_EQ(1, count(reader, "name==B"));
+    ASSERT_EQ(1, count(reader, "name==D"));
+  }
+
+  // copy segment files as-is
+  {
+    irs::index_meta data_meta;
+    std::string filename;
+    auto meta_reader = codec()->get_index_meta_reader();
+    ASSERT_TRUE(meta_reader->last_segments_file(data_dir, filename));
+    meta_reader->read(data_dir, data_meta, filename);
+
+    irs::index_writer::import_options opts;
+    opts.copy_segments = true;
+    ASSERT_TRUE(writer->import(data_dir, data_meta, opts));
+    writer->commit();
+
+    auto reader = irs::directory_reader::open(dir(), codec());
+    ASSERT_EQ(5, reader.size());
+    ASSERT_EQ(7, reader.docs_count()); // removal is copied as-is
+    ASSERT_EQ(6, reader.live_docs_count());
+    ASSERT_EQ(0, count(reader, "name==A"));
+    ASSERT_EQ(2, count(reader, "name==B"));
+    ASSERT_EQ(2, count(reader, "name==C"));
+    ASSERT_EQ(2, count(reader, "name==D"));
+
+    // files of copied segments are named after the new segments
+    irs::index_meta meta;
+    ASSERT_TRUE(meta_reader->last_segments_file(dir(), filename));
+    meta_reader->read(dir(), meta, filename);
+
+    for (auto& segment : meta) {
+      for (auto& file : segment.meta.files) {
+        ASSERT_TRUE(irs::starts_with(file, irs::string_ref(segment.meta.name)));
+      }
+    }
+  }
+}
+
+TEST_F(memory_index_test, writer_reader) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory
+  );
+  tests::document const* doc1 = gen.next();
+  tests::document const* doc2 = gen.next();
+  tests::document const* doc3 = gen.next();
+  tests::document const* doc4 = gen.next();
+
+  auto writer = open_writer();
+
+  ASSERT_TRUE(insert(*writer, doc1->indexed.begin(), doc1->indexed.end()));
+
+  // flushed but not committed
+  auto reader = writer->reader();
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(1, reader.live_docs_count());
+  ASSERT_THROW(irs::directory_reader::open(dir(), codec()), irs::index_not_found);
+
+  // nothing changed, segment readers are reused
+  {
+    auto same_reader = writer->reader(reader);
+    ASSERT_EQ(reader, same_reader);
+  }
+
+  ASSERT_TRUE(insert(*writer, doc2->indexed.begin(), doc2->indexed.end()));
+  reader = writer->reader(reader);
+  ASSERT_EQ(2, reader.size());
+  ASSERT_EQ(2, reader.live_docs_count());
+
+  // rollback discards changes flushed by reader()
+  writer->rollback();
+  reader = writer->reader();
+  ASSERT_EQ(0, reader.size());
+
+  ASSERT_TRUE(insert(*writer, doc3->indexed.begin(), doc3->indexed.end()));
+  reader = writer->reader();
+  ASSERT_EQ(1, reader.size());
+
+  // commit makes changes flushed by reader() durable
+  ASSERT_TRUE(insert(*writer, doc4->indexed.begin(), doc4->indexed.end()));
+  writer->commit();
+
+  {
+    auto committed = irs::directory_reader::open(dir(), codec());
+    ASSERT_EQ(2, committed.size());
+    ASSERT_EQ(2, committed.live_docs_count());
+    ASSERT_EQ(2, writer->reader().live_docs_count());
+  }
+
+  // begin() holds the state of the started transaction
+  ASSERT_TRUE(insert(*writer, doc1->indexed.begin(), doc1->indexed.end()));
+  ASSERT_TRUE(writer->begin());
+  ASSERT_EQ(3, writer->reader().live_docs_count());
+  writer->commit();
+  ASSERT_EQ(3, irs::directory_reader::open(dir(), codec()).live_docs_count());
+}
+
 TEST_F(memory_index_test, import_reader) {
   tests::json_doc_generator gen(
     resource("simple_sequential.json"),
@@ -15041,6 +15363,50 @@ TEST_F(memory_index_test, refresh_reader) {
   }
 }
 
+TEST_F(memory_index_test, refresh_reader_shared_state) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory
+  );
+  tests::document const* doc1 = gen.next();
+  tests::document const* doc2 = gen.next();
+  tests::document const* doc3 = gen.next();
+
+  auto query_doc1 = irs::iql::query_builder().build("name==A", std::locale::classic());
+  auto writer = open_writer();
+
+  ASSERT_TRUE(insert(*writer, doc1->indexed.begin(), doc1->indexed.end(), doc1->stored.begin(), doc1->stored.end()));
+  ASSERT_TRUE(insert(*writer, doc2->indexed.begin(), doc2->indexed.end(), doc2->stored.begin(), doc2->stored.end()));
+  writer->commit();
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(2, reader.live_docs_count());
+
+  // only the document mask changes
+  writer->documents().remove(*query_doc1.filter);
+  writer->commit();
+
+  auto new_reader = reader.reopen(codec());
+  ASSERT_NE(reader, new_reader);
+  ASSERT_EQ(1, new_reader.size());
+  ASSERT_EQ(2, reader.live_docs_count()); // old snapshot is unaffected
+  ASSERT_EQ(1, new_reader.live_docs_count());
+  ASSERT_EQ(reader[0].field("name"), new_reader[0].field("name")); // shared term dictionary
+  ASSERT_NE(nullptr, reader[0].column_reader("name"));
+  ASSERT_EQ(reader[0].column_reader("name"), new_reader[0].column_reader("name")); // shared columnstore
+  ASSERT_EQ(reader[0].column("name"), new_reader[0].column("name")); // shared column meta
+
+  // a new segment does not affect the existing one
+  ASSERT_TRUE(insert(*writer, doc3->indexed.begin(), doc3->indexed.end(), doc3->stored.begin(), doc3->stored.end()));
+  writer->commit();
+
+  auto last_reader = new_reader.reopen(codec());
+  ASSERT_EQ(2, last_reader.size());
+  ASSERT_EQ(2, last_reader.live_docs_count());
+  ASSERT_EQ(new_reader[0].field("name"), last_reader[0].field("name")); // segment reader reused
+}
+
 TEST_F(memory_index_test, reuse_segment_writer) {
   tests::json_doc_generator gen0(resource("arango_demo.json"), &tests::generic_json_field_factory);
   tests::json_doc_generator gen1(resource("simple_sequential.json"), &tests::generic_json_field_factory);
@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index_tests.hpp"
+
+#include "search/term_filter.hpp"
+#include "store/memory_directory.hpp"
+#include "utils/index_utils.hpp"
+
+NS_LOCAL
+
+void insert_doc(
+    irs::index_writer& writer,
+    const irs::string_ref& name,
+    const int64_t* timestamp) {
+  tests::templates::string_field name_field("name", name);
+  tests::long_field ts_field;
+  ts_field.name("ts");
+
+  auto ctx = writer.documents();
+  auto doc = ctx.insert();
+
+  ASSERT_TRUE(doc.insert(irs::action::index_store, name_field));
+
+  if (timestamp) {
+    ts_field.value(*timestamp);
+    ASSERT_TRUE(doc.insert(irs::action::store, ts_field));
+  }
+}
+
+void insert_doc(
+    irs::index_writer& writer,
+    const irs::string_ref& name,
+    int64_t timestamp) {
+  insert_doc(writer, name, &timestamp);
+}
+
+std::set<std::string> names(const irs::index_reader& reader) {
+  std::set<std::string> names;
+
+  for (auto& segment : reader) {
+    auto* column = segment.column_reader("name");
+    EXPECT_NE(nullptr, column);
+
+    column->visit([&names](irs::doc_id_t, const irs::bytes_ref& value) {
+      names.emplace(irs::to_string<irs::string_ref>(value.c_str()));
+      return true;
+    });
+  }
+
+  return names;
+}
+
+irs::index_writer::options ttl_options() {
+  irs::index_writer::options options;
+  options.ttl_column = "ts";
+  options.ttl_partition = 100;
+
+  return options;
+}
+
+NS_END
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST(index_writer_ttl_tests, expire_disabled) {
+  irs::memory_directory dir;
+  auto writer = irs::index_writer::make(dir, irs::formats::get("1_0"), irs::OM_CREATE);
+
+  insert_doc(*writer, "A", 10);
+  writer->commit();
+
+  ASSERT_FALSE(writer->expire(100));
+  writer->commit();
+
+  auto reader = irs::directory_reader::open(dir);
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(1, reader.live_docs_count());
+}
+
+TEST(index_writer_ttl_tests, expire) {
+  irs::memory_directory dir;
+  auto codec = irs::formats::get("1_0");
+  auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE, ttl_options());
+
+  insert_doc(*writer, "A", 10);
+  insert_doc(*writer, "B", 20);
+  writer->commit();
+  insert_doc(*writer, "C", 150);
+  writer->commit();
+  insert_doc(*writer, "D", nullptr); // no timestamp
+  writer->commit();
+
+  // nothing expired yet
+  ASSERT_TRUE(writer->expire(20));
+  writer->commit();
+  ASSERT_EQ(3, irs::directory_reader::open(dir, codec).size());
+
+  // whole segment is dropped without a document mask
+  ASSERT_TRUE(writer->expire(21));
+  writer->commit();
+
+  {
+    auto reader = irs::directory_reader::open(dir, codec);
+    ASSERT_EQ(2, reader.size());
+    ASSERT_EQ(reader.docs_count(), reader.live_docs_count());
+    ASSERT_EQ((std::set<std::string>{ "C", "D" }), names(reader));
+  }
+
+  // watermark never decreases, segments flushed later expire as well
+  ASSERT_TRUE(writer->expire(0));
+  insert_doc(*writer, "E", 15);
+  writer->commit();
+  ASSERT_EQ(3, irs::directory_reader::open(dir, codec).size());
+  writer->commit(); // committed segments are checked against the watermark
+  ASSERT_EQ(
+    (std::set<std::string>{ "C", "D" }),
+    names(irs::directory_reader::open(dir, codec))
+  );
+  insert_doc(*writer, "F", 160);
+  writer->commit();
+
+  {
+    auto reader = irs::directory_reader::open(dir, codec);
+    ASSERT_EQ((std::set<std::string>{ "C", "D", "F" }), names(reader));
+  }
+
+  // segments without timestamps never expire
+  ASSERT_TRUE(writer->expire(1000));
+  writer->commit();
+
+  {
+    auto reader = irs::directory_reader::open(dir, codec);
+    ASSERT_EQ(1, reader.size());
+    ASSERT_EQ((std::set<std::string>{ "D" }), names(reader));
+  }
+}
+
+TEST(index_writer_ttl_tests, expire_partially_timestamped) {
+  irs::memory_directory dir;
+  auto codec = irs::formats::get("1_0");
+  auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE, ttl_options());
+
+  insert_doc(*writer, "A", 10);
+  insert_doc(*writer, "B", nullptr); // no timestamp
+  insert_doc(*writer, "C", 20);
+  writer->commit();
+  insert_doc(*writer, "D", 30);
+  writer->commit();
+
+  // segment with a document without a timestamp is kept as a whole
+  ASSERT_TRUE(writer->expire(1000));
+  writer->commit();
+
+  auto reader = irs::directory_reader::open(dir, codec);
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(3, reader.live_docs_count());
+  ASSERT_EQ((std::set<std::string>{ "A", "B", "C" }), names(reader));
+}
+
+TEST(index_writer_ttl_tests, expire_replaced) {
+  irs::memory_directory dir;
+  auto codec = irs::formats::get("1_0");
+  auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE, ttl_options());
+
+  insert_doc(*writer, "A", 10);
+  insert_doc(*writer, "B", 20);
+  writer->commit();
+
+  // replacement of a document of an expiring segment is kept
+  ASSERT_TRUE(writer->expire(100));
+
+  {
+    irs::by_term filter;
+    filter.field("name").term(irs::ref_cast<irs::byte_type>(irs::string_ref("A")));
+
+    tests::templates::string_field name_field("name", "A2");
+    tests::long_field ts_field;
+    ts_field.name("ts");
+    ts_field.value(150);
+
+    auto ctx = writer->documents();
+    auto doc = ctx.replace(filter);
+    ASSERT_TRUE(doc.insert(irs::action::index_store, name_field));
+    ASSERT_TRUE(doc.insert(irs::action::store, ts_field));
+  }
+
+  writer->commit();
+
+  auto reader = irs::directory_reader::open(dir, codec);
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(1, reader.live_docs_count());
+  ASSERT_EQ((std::set<std::string>{ "A2" }), names(reader));
+}
+
+TEST(index_writer_ttl_tests, consolidate_partitioned) {
+  irs::memory_directory dir;
+  auto codec = irs::formats::get("1_0");
+  auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE, ttl_options());
+  auto policy = irs::index_utils::consolidation_policy(
+    irs::index_utils::consolidate_count()
+  );
+
+  insert_doc(*writer, "A", 150);
+  writer->commit();
+  insert_doc(*writer, "B", 10);
+  writer->commit();
+  insert_doc(*writer, "C", 160);
+  writer->commit();
+  insert_doc(*writer, "D", 90);
+  writer->commit();
+  insert_doc(*writer, "E", nullptr);
+  writer->commit();
+  insert_doc(*writer, "F", nullptr);
+  writer->commit();
+  ASSERT_EQ(6, irs::directory_reader::open(dir, codec).size());
+
+  auto segments = [&dir, &codec]()->std::vector<std::set<std::string>> {
+    std::vector<std::set<std::string>> segments;
+
+    for (auto& segment : irs::directory_reader::open(dir, codec)) {
+      segments.emplace_back(names(segment));
+    }
+
+    std::sort(segments.begin(), segments.end());
+
+    return segments;
+  };
+
+  // oldest partition first
+  ASSERT_TRUE(writer->consolidate(policy));
+  writer->commit();
+  ASSERT_EQ(
+    (std::vector<std::set<std::string>>{
+      { "A" }, { "B", "D" }, { "C" }, { "E" }, { "F" }
+    }),
+    segments()
+  );
+
+  // partitions are never mixed
+  ASSERT_TRUE(writer->consolidate(policy));
+  writer->commit();
+  ASSERT_EQ(
+    (std::vector<std::set<std::string>>{
+      { "A", "C" }, { "B", "D" }, { "E" }, { "F" }
+    }),
+    segments()
+  );
+
+  // segments without timestamps are consolidated last
+  ASSERT_TRUE(writer->consolidate(policy));
+  writer->commit();
+  ASSERT_EQ(
+    (std::vector<std::set<std::string>>{
+      { "A", "C" }, { "B", "D" }, { "E", "F" }
+    }),
+    segments()
+  );
+
+  // nothing left to consolidate
+  ASSERT_TRUE(writer->consolidate(policy));
+  writer->commit();
+  ASSERT_EQ(3, irs::directory_reader::open(dir, codec).size());
+
+  // consolidated segment expires as a whole
+  ASSERT_TRUE(writer->expire(100));
+  writer->commit();
+  ASSERT_EQ(
+    (std::vector<std::set<std::string>>{ { "A", "C" }, { "E", "F" } }),
+    segments()
+  );
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index_tests.hpp"
+
+#include "index/reader_manager.hpp"
+#include "store/memory_directory.hpp"
+#include "utils/index_utils.hpp"
+
+#include <thread>
+
+NS_LOCAL
+
+void insert_doc(irs::index_writer& writer, const irs::string_ref& value) {
+  tests::templates::string_field field("name", value);
+  auto ctx = writer.documents();
+
+  ASSERT_TRUE(ctx.insert().insert(irs::action::index, field));
+}
+
+NS_END
+
+TEST(reader_manager_tests, open_no_index) {
+  irs::memory_directory dir;
+
+  ASSERT_THROW(irs::reader_manager::make(dir, irs::formats::get("1_0")), irs::index_not_found);
+
+  irs::reader_manager::options options;
+  options.cleanup = true;
+  ASSERT_THROW(irs::reader_manager::make(dir, nullptr, options), irs::illegal_argument);
+}
+
+TEST(reader_manager_tests, acquire_refresh) {
+  irs::memory_directory dir;
+  auto codec = irs::formats::get("1_0");
+  auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE);
+
+  insert_doc(*writer, "A");
+  writer->commit();
+
+  irs::reader_manager::options options;
+  options.cleanup = true;
+  auto manager = irs::reader_manager::make(dir, codec, options);
+  ASSERT_NE(nullptr, manager);
+
+  auto snapshot = manager->acquire();
+  ASSERT_EQ(1, snapshot.live_docs_count());
+  ASSERT_EQ(snapshot, manager->acquire()); // same snapshot until refreshed
+  ASSERT_FALSE(manager->refresh()); // nothing changed
+
+  insert_doc(*writer, "B");
+  writer->commit();
+  ASSERT_TRUE(manager->refresh());
+
+  // acquired snapshot is stable
+  ASSERT_EQ(1, snapshot.live_docs_count());
+  ASSERT_EQ(2, manager->acquire().live_docs_count());
+
+  // files of an acquired snapshot survive consolidation and cleanup
+  ASSERT_TRUE(writer->consolidate(irs::index_utils::consolidation_policy(irs::index_utils::consolidate_count())));
+  writer->commit();
+  ASSERT_TRUE(manager->refresh());
+  ASSERT_EQ(1, manager->acquire().size());
+
+  {
+    auto& segment = snapshot[0];
+    auto docs = segment.docs_iterator();
+    ASSERT_TRUE(docs->next());
+    ASSERT_FALSE(docs->next());
+    ASSERT_NE(nullptr, segment.field("name"));
+  }
+}
+
+TEST(reader_manager_tests, background_refresh) {
+  irs::memory_directory dir;
+  auto codec = irs::formats::get("1_0");
+  auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE);
+
+  insert_doc(*writer, "A");
+  writer->commit();
+
+  irs::reader_manager::options options;
+  options.refresh_interval = std::chrono::milliseconds(1);
+  auto manager = irs::reader_manager::make(dir, codec, options);
+  ASSERT_EQ(1, manager->acquire().live_docs_count());
+
+  insert_doc(*writer, "B");
+  writer->commit();
+
+  for (size_t i = 0; i < 1000 && 2 != manager->acquire().live_docs_count(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  ASSERT_EQ(2, manager->acquire().live_docs_count());
+  manager.reset(); // stops background refresh
+}
@@ -3205,7 +3205,9 @@ TEST_F(transaction_store_tests, concurrent_read_index_mt) {
 
             auto& actual_attrs = act_docs_itr->attributes();
             auto& expected_attrs = exp_docs_itr->attributes();
-            ASSERT_EQ(expected_attrs.features(), actual_attrs.features());
+            auto actual_features = actual_attrs.features();
+            actual_features.remove<irs::block_bounds>(); // optional, exposed by multi-block postings only
+            ASSERT_EQ(expected_attrs.features(), actual_features);
 
             auto& actual_freq = actual_attrs.get<irs::frequency>();
             auto& expected_freq = expected_attrs.get<irs::frequency>();
@@ -39,6 +39,8 @@
 #include "utils/singleton.hpp"
 
 #include <functional>
+#include <map>
+#include <set>
 
 // ----------------------------------------------------------------------------
 // --SECTION--                                                   Iterator tests
@@ -3664,6 +3666,270 @@ TEST(disjunction_test, scored_seek_next) {
   }
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--        Block disjunction: iterator0 OR iterator1 OR iterator2 OR ...
+// ----------------------------------------------------------------------------
+
+TEST(block_disjunction_test, next) {
+  using disjunction = irs::block_disjunction;
+
+  // simple case
+  {
+    std::vector<std::vector<irs::doc_id_t>> docs{
+      { 1, 2, 5, 7, 9, 11, 45 },
+      { 1, 5, 6, 12, 29 }
+    };
+    std::vector<irs::doc_id_t> expected{ 1, 2, 5, 6, 7, 9, 11, 12, 29, 45 };
+    std::vector<irs::doc_id_t> result;
+    {
+      disjunction it(detail::execute_all<irs::score_iterator_adapter>(docs));
+      ASSERT_EQ(12, irs::cost::extract(it.attributes()));
+      ASSERT_FALSE(irs::type_limits<irs::type_t::doc_id_t>::valid(it.value()));
+      for ( ; it.next(); ) {
+        result.push_back(it.value());
+      }
+      ASSERT_FALSE(it.next());
+      ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it.value()));
+    }
+
+    ASSERT_EQ(expected, result);
+  }
+
+  // empty
+  {
+    disjunction it(disjunction::doc_iterators_t{});
+    ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it.value()));
+    ASSERT_FALSE(it.next());
+  }
+
+  // documents spanning several windows, including a window without matches
+  {
+    std::vector<std::vector<irs::doc_id_t>> docs(10);
+    std::set<irs::doc_id_t> expected;
+
+    for (irs::doc_id_t doc = 1; doc < 5 * disjunction::WINDOW; ++doc) {
+      const auto i = doc % 17;
+
+      if (i < docs.size() && (doc < disjunction::WINDOW || doc > 3 * disjunction::WINDOW)) {
+        docs[i].push_back(doc);
+        expected.insert(doc);
+      }
+    }
+
+    docs.back().push_back(100000); // far away document
+
+    expected.insert(100000);
+
+    std::vector<irs::doc_id_t> result;
+    disjunction it(detail::execute_all<irs::score_iterator_adapter>(docs));
+
+    while (it.next()) {
+      result.push_back(it.value());
+    }
+
+    ASSERT_EQ(std::vector<irs::doc_id_t>(expected.begin(), expected.end()), result);
+  }
+}
+
+TEST(block_disjunction_test, seek_next) {
+  using disjunction = irs::block_disjunction;
+
+  {
+    std::vector<std::vector<irs::doc_id_t>> docs{
+      { 1, 2, 5, 7, 9, 11, 45 },
+      { 1, 5, 6, 12, 29 },
+      { 1, 5, 6 }
+    };
+
+    disjunction it(detail::execute_all<irs::score_iterator_adapter>(docs));
+
+    // score
+    ASSERT_EQ(nullptr, it.attributes().get<irs::score>()); // no order set
+    auto& score = irs::score::extract(it.attributes());
+    ASSERT_EQ(&irs::score::no_score(), &score);
+
+    ASSERT_EQ(irs::type_limits<irs::type_t::doc_id_t>::invalid(), it.value());
+    ASSERT_EQ(5, it.seek(5));
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(6, it.value());
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(7, it.value());
+    ASSERT_EQ(7, it.seek(3)); // seek backwards
+    ASSERT_EQ(29, it.seek(27));
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(45, it.value());
+    ASSERT_FALSE(it.next());
+    ASSERT_EQ(irs::type_limits<irs::type_t::doc_id_t>::eof(), it.value());
+    ASSERT_EQ(irs::type_limits<irs::type_t::doc_id_t>::eof(), it.seek(50));
+  }
+
+  // seek across windows
+  {
+    std::vector<std::vector<irs::doc_id_t>> docs(3);
+
+    for (irs::doc_id_t doc = 1; doc < 10 * disjunction::WINDOW; ++doc) {
+      if (0 == doc % 7) docs[0].push_back(doc);
+      if (0 == doc % 11) docs[1].push_back(doc);
+      if (0 == doc % 13) docs[2].push_back(doc);
+    }
+
+    std::set<irs::doc_id_t> expected;
+
+    for (auto& entry : docs) {
+      expected.insert(entry.begin(), entry.end());
+    }
+
+    disjunction it(detail::execute_all<irs::score_iterator_adapter>(docs));
+
+    for (irs::doc_id_t target = 1; target < 10 * disjunction::WINDOW; target += 997) {
+      const auto expected_doc = expected.lower_bound(target);
+      ASSERT_NE(expected.end(), expected_doc);
+      ASSERT_EQ(*expected_doc, it.seek(target));
+
+      // next stays in sync with the expected documents
+      ASSERT_TRUE(it.next());
+      ASSERT_EQ(*std::next(expected_doc), it.value());
+    }
+  }
+}
+
+TEST(block_disjunction_test, scored_seek_next) {
+  using disjunction = irs::block_disjunction;
+
+  std::vector<std::pair<std::vector<irs::doc_id_t>, irs::order>> docs;
+  {
+    irs::order ord;
+    ord.add<detail::basic_sort>(false, 1);
+    docs.emplace_back(std::vector<irs::doc_id_t>{ 1, 2, 5, 7, 9, 11, 45, 5000 }, std::move(ord));
+  }
+  {
+    irs::order ord;
+    docs.emplace_back(std::vector<irs::doc_id_t>{ 1, 5, 6, 12, 29, 5000 }, std::move(ord));
+  }
+  {
+    irs::order ord;
+    ord.add<detail::basic_sort>(false, 4);
+    docs.emplace_back(std::vector<irs::doc_id_t>{ 1, 5, 6, 5000 }, std::move(ord));
+  }
+
+  irs::order ord;
+  ord.add<detail::basic_sort>(false, std::numeric_limits<size_t>::max());
+  auto prepared_order = ord.prepare();
+
+  auto res = detail::execute_all<irs::score_iterator_adapter>(docs);
+  disjunction it(std::move(res.first), prepared_order, 1); // custom cost
+
+  // score
+  ASSERT_NE(nullptr, it.attributes().get<irs::score>());
+  auto& score = irs::score::extract(it.attributes());
+  ASSERT_FALSE(score.empty());
+
+  // cost
+  ASSERT_EQ(1, irs::cost::extract(it.attributes()));
+
+  ASSERT_TRUE(it.next());
+  ASSERT_EQ(1, it.value());
+  score.evaluate();
+  ASSERT_EQ(5, *reinterpret_cast<const size_t*>(score.c_str())); // 1+4
+  ASSERT_EQ(5, it.seek(5));
+  score.evaluate();
+  ASSERT_EQ(5, *reinterpret_cast<const size_t*>(score.c_str())); // 1+4
+  ASSERT_TRUE(it.next());
+  ASSERT_EQ(6, it.value());
+  score.evaluate();
+  ASSERT_EQ(4, *reinterpret_cast<const size_t*>(score.c_str())); // 4
+  ASSERT_EQ(12, it.seek(12));
+  score.evaluate();
+  ASSERT_EQ(0, *reinterpret_cast<const size_t*>(score.c_str())); // unscored
+  ASSERT_TRUE(it.next());
+  ASSERT_EQ(29, it.value());
+  ASSERT_EQ(5000, it.seek(46)); // next window
+  score.evaluate();
+  ASSERT_EQ(5, *reinterpret_cast<const size_t*>(score.c_str())); // 1+4
+  ASSERT_FALSE(it.next());
+  ASSERT_EQ(irs::type_limits<irs::type_t::doc_id_t>::eof(), it.value());
+}
+
+TEST(block_disjunction_test, min_match) {
+  using disjunction = irs::block_disjunction;
+
+  std::vector<std::vector<irs::doc_id_t>> docs(9);
+  std::map<irs::doc_id_t, size_t> counts;
+
+  for (irs::doc_id_t doc = 1; doc < 4 * disjunction::WINDOW; ++doc) {
+    for (size_t i = 0; i < docs.size(); ++i) {
+      if (0 == doc % (i + 2)) {
+        docs[i].push_back(doc);
+        ++counts[doc];
+      }
+    }
+  }
+
+  for (size_t min_match_count : { 1, 2, 3, 5, 9, 10 }) {
+    std::vector<irs::doc_id_t> expected;
+
+    for (auto& entry : counts) {
+      if (entry.second >= min_match_count) {
+        expected.push_back(entry.first);
+      }
+    }
+
+    std::vector<irs::doc_id_t> result;
+    disjunction it(
+      detail::execute_all<irs::score_iterator_adapter>(docs), min_match_count
+    );
+
+    while (it.next()) {
+      result.push_back(it.value());
+    }
+
+    ASSERT_EQ(expected, result);
+
+    // seek fills narrow windows, next fills complete ones
+    disjunction seek_it(
+      detail::execute_all<irs::score_iterator_adapter>(docs), min_match_count
+    );
+
+    for (irs::doc_id_t target = 1; target < 4 * disjunction::WINDOW; target += 331) {
+      if (irs::type_limits<irs::type_t::doc_id_t>::valid(seek_it.value())) {
+        target = (std::max)(target, irs::doc_id_t(seek_it.value() + 1)); // no seeking backwards
+      }
+
+      const auto expected_doc = std::lower_bound(expected.begin(), expected.end(), target);
+
+      if (expected_doc == expected.end()) {
+        ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(seek_it.seek(target)));
+        break;
+      }
+
+      ASSERT_EQ(*expected_doc, seek_it.seek(target));
+
+      for (auto next = std::next(expected_doc), end = (std::min)(next + 3, expected.end()); next != end; ++next) {
+        ASSERT_TRUE(seek_it.next());
+        ASSERT_EQ(*next, seek_it.value());
+      }
+    }
+  }
+}
+
+TEST(block_disjunction_test, worthwhile) {
+  using disjunction = irs::block_disjunction;
+
+  // too few clauses
+  ASSERT_FALSE(disjunction::worthwhile(disjunction::MIN_SIZE - 1, 1000000, 1000000));
+
+  // dense clauses, at least a document per clause in a window
+  ASSERT_TRUE(disjunction::worthwhile(16, 1000000, 1000000));
+  ASSERT_TRUE(disjunction::worthwhile(16, 16 * (1 << 20) / disjunction::WINDOW, 1 << 20));
+
+  // sparse clauses, e.g. terms of a range, most windows hold a single document
+  ASSERT_FALSE(disjunction::worthwhile(10000, 10000, 1000000));
+  ASSERT_FALSE(disjunction::worthwhile(16, 16 * (1 << 20) / disjunction::WINDOW - 1, 1 << 20));
+
+  // unknown cost
+  ASSERT_FALSE(disjunction::worthwhile(16, 0, 1000000));
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--  Minimum match count: iterator0 OR iterator1 OR iterator2 OR ...
 // ----------------------------------------------------------------------------
@@ -5549,6 +5815,118 @@ TEST(conjunction_test, scored_seek_next) {
   }
 }
 
+NS_LOCAL
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class bounded_doc_iterator
+/// @brief doc iterator exposing block bounds, remembers every seek target
+////////////////////////////////////////////////////////////////////////////////
+class bounded_doc_iterator : public irs::doc_iterator {
+ public:
+  explicit bounded_doc_iterator(const std::vector<irs::doc_id_t>& docs)
+    : docs_(docs), bounds_(*this) {
+    est_.value(docs_.size());
+    attrs_.emplace(est_);
+    attrs_.emplace<irs::block_bounds>(bounds_);
+  }
+
+  virtual irs::doc_id_t value() const override {
+    return doc_;
+  }
+
+  virtual bool next() override {
+    if (pos_ == docs_.size()) {
+      doc_ = irs::type_limits<irs::type_t::doc_id_t>::eof();
+      return false;
+    }
+
+    doc_ = docs_[pos_++];
+    return true;
+  }
+
+  virtual irs::doc_id_t seek(irs::doc_id_t target) override {
+    seeks_.push_back(target);
+
+    while (doc_ < target && next()) { }
+    return doc_;
+  }
+
+  virtual const irs::attribute_view& attributes() const NOEXCEPT override {
+    return attrs_;
+  }
+
+  const std::vector<irs::doc_id_t>& seeks() const NOEXCEPT {
+    return seeks_;
+  }
+
+ private:
+  class bounds final : public irs::block_bounds {
+   public:
+    explicit bounds(const bounded_doc_iterator& it) NOEXCEPT
+      : it_(&it) {
+    }
+
+    virtual irs::doc_id_t shallow_seek(irs::doc_id_t target) override {
+      if (target <= it_->doc_) {
+        return it_->doc_;
+      }
+
+      auto& docs = it_->docs_;
+      auto next = std::lower_bound(docs.begin() + it_->pos_, docs.end(), target);
+
+      if (next == docs.end()) {
+        return irs::type_limits<irs::type_t::doc_id_t>::eof();
+      }
+
+      min_ = max_ = *next;
+      return *next;
+    }
+
+   private:
+    const bounded_doc_iterator* it_;
+  }; // bounds
+
+  std::vector<irs::doc_id_t> docs_;
+  std::vector<irs::doc_id_t> seeks_;
+  irs::attribute_view attrs_;
+  irs::cost est_;
+  bounds bounds_;
+  size_t pos_{};
+  irs::doc_id_t doc_{ irs::type_limits<irs::type_t::doc_id_t>::invalid() };
+}; // bounded_doc_iterator
+
+NS_END
+
+TEST(conjunction_test, block_bounds) {
+  std::vector<irs::doc_id_t> sparse{ 5, 500, 1005, 2000 };
+  std::vector<irs::doc_id_t> dense{ 1, 2, 3, 4, 5, 6, 1000, 1001, 1002, 1005, 1006 };
+
+  std::vector<irs::score_iterator_adapter> itrs;
+  itrs.emplace_back(irs::doc_iterator::make<bounded_doc_iterator>(sparse));
+  itrs.emplace_back(irs::doc_iterator::make<bounded_doc_iterator>(dense));
+
+  auto& sparse_it = dynamic_cast<const bounded_doc_iterator&>(*itrs[0].it);
+  auto& dense_it = dynamic_cast<const bounded_doc_iterator&>(*itrs[1].it);
+
+  irs::conjunction it(std::move(itrs));
+  ASSERT_EQ(sparse.size(), irs::cost::extract(it.attributes()));
+
+  ASSERT_TRUE(it.next());
+  ASSERT_EQ(5, it.value());
+  ASSERT_TRUE(it.next());
+  ASSERT_EQ(1005, it.value());
+  ASSERT_FALSE(it.next());
+  ASSERT_EQ(irs::type_limits<irs::type_t::doc_id_t>::eof(), it.value());
+
+  // the lead is moved over the gaps of the dense iterator,
+  // documents falling into those gaps are never sought
+  auto& sparse_seeks = sparse_it.seeks();
+  ASSERT_NE(sparse_seeks.end(), std::find(sparse_seeks.begin(), sparse_seeks.end(), 1005));
+  auto& dense_seeks = dense_it.seeks();
+  ASSERT_EQ(dense_seeks.end(), std::find(dense_seeks.begin(), dense_seeks.end(), 500));
+  ASSERT_EQ(dense_seeks.end(), std::find(dense_seeks.begin(), dense_seeks.end(), 2000));
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                      iterator0 AND NOT iterator1
 // ----------------------------------------------------------------------------
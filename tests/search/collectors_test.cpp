@@ -0,0 +1,335 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "filter_test_case_base.hpp"
+#include "index/index_tests.hpp"
+#include "search/collectors.hpp"
+#include "search/term_filter.hpp"
+#include "store/memory_directory.hpp"
+
+NS_LOCAL
+
+irs::directory_reader make_index(irs::directory& dir) {
+  auto writer = irs::index_writer::make(dir, irs::formats::get("1_0"), irs::OM_CREATE);
+
+  for (size_t count : { 100, 100, 50 }) {
+    {
+      auto ctx = writer->documents();
+
+      for (size_t i = 0; i < count; ++i) {
+        tests::templates::string_field name("name", "A");
+        EXPECT_TRUE(ctx.insert().insert(irs::action::index, name));
+      }
+    }
+
+    writer->commit(); // one segment per commit
+  }
+
+  return irs::directory_reader::open(dir);
+}
+
+typedef std::vector<irs::top_docs_collector::entry> entries_t;
+
+entries_t collect_all_pages(
+    const irs::index_reader& reader,
+    const irs::filter::prepared& filter,
+    const irs::order::prepared& order,
+    size_t page_size) {
+  entries_t hits;
+  std::string cursor;
+
+  for (;;) {
+    irs::top_docs_collector::entry after;
+    const bool has_after = !cursor.empty();
+
+    if (has_after) {
+      EXPECT_TRUE(irs::top_docs_collector::from_cursor(after, cursor));
+    }
+
+    irs::top_docs_collector collector(
+      order, page_size, has_after ? &after : nullptr
+    );
+    size_t ordinal = 0;
+
+    for (auto& segment : reader) {
+      collector.collect(ordinal++, *filter.execute(segment, order));
+    }
+
+    auto page = collector.top();
+
+    if (page.empty()) {
+      EXPECT_TRUE(collector.cursor().empty());
+      return hits;
+    }
+
+    EXPECT_LE(page.size(), page_size);
+    EXPECT_EQ(irs::top_docs_collector::to_cursor(page.back()), collector.cursor());
+    hits.insert(hits.end(), page.begin(), page.end());
+    cursor = collector.cursor();
+  }
+}
+
+NS_END
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST(total_hits_collector_test, collect) {
+  irs::memory_directory dir;
+  auto reader = make_index(dir);
+  ASSERT_EQ(3, reader.size());
+
+  irs::by_term filter;
+  filter.field("name").term("A");
+  auto prepared = filter.prepare(reader);
+
+  // exact
+  {
+    irs::total_hits_collector collector;
+
+    for (auto& segment : reader) {
+      collector.collect(*prepared->execute(segment));
+    }
+
+    auto hits = collector.hits();
+    ASSERT_TRUE(hits.exact);
+    ASSERT_EQ(250, hits.value);
+    ASSERT_EQ(250, hits.estimate);
+  }
+
+  // threshold within the second segment
+  {
+    irs::total_hits_collector collector(150);
+
+    for (auto& segment : reader) {
+      collector.collect(*prepared->execute(segment));
+    }
+
+    auto hits = collector.hits();
+    ASSERT_FALSE(hits.exact);
+    ASSERT_EQ(150, hits.value);
+    ASSERT_EQ(250, hits.estimate); // from cost of the remaining postings
+  }
+
+  // threshold above the number of hits
+  {
+    irs::total_hits_collector collector(251);
+
+    for (auto& segment : reader) {
+      collector.collect(*prepared->execute(segment));
+    }
+
+    auto hits = collector.hits();
+    ASSERT_TRUE(hits.exact);
+    ASSERT_EQ(250, hits.value);
+  }
+
+  // empty segment
+  {
+    irs::total_hits_collector collector(1);
+    collector.collect(*irs::doc_iterator::empty());
+    collector.finish(*irs::doc_iterator::empty());
+
+    auto hits = collector.hits();
+    ASSERT_TRUE(hits.exact);
+    ASSERT_EQ(0, hits.value);
+    ASSERT_EQ(0, hits.estimate);
+  }
+}
+
+TEST(total_hits_collector_test, collect_iterated) {
+  irs::memory_directory dir;
+  auto reader = make_index(dir);
+
+  irs::by_term filter;
+  filter.field("name").term("A");
+  auto prepared = filter.prepare(reader);
+
+  irs::total_hits_collector collector(10);
+  size_t iterated = 0;
+
+  for (auto& segment : reader) {
+    auto docs = prepared->execute(segment);
+
+    while (collector.hits().value < collector.threshold() && docs->next()) {
+      ++iterated;
+
+      if (!collector.collect()) {
+        break; // e.g. unordered top-k is complete as well
+      }
+    }
+
+    collector.finish(*docs); // segments not iterated at all are estimated
+  }
+
+  auto hits = collector.hits();
+  ASSERT_EQ(10, iterated);
+  ASSERT_FALSE(hits.exact);
+  ASSERT_EQ(10, hits.value);
+  ASSERT_EQ(250, hits.estimate);
+}
+
+TEST(top_docs_collector_test, cursor) {
+  irs::top_docs_collector::entry expected;
+  expected.score = irs::ref_cast<irs::byte_type>(irs::string_ref("\x00\x7F\xFF", 3));
+  expected.segment = 42;
+  expected.doc = 100500;
+
+  const auto token = irs::top_docs_collector::to_cursor(expected);
+  ASSERT_EQ(std::string::npos, token.find_first_not_of("0123456789abcdef"));
+
+  irs::top_docs_collector::entry actual;
+  ASSERT_TRUE(irs::top_docs_collector::from_cursor(actual, token));
+  ASSERT_EQ(expected.score, actual.score);
+  ASSERT_EQ(expected.segment, actual.segment);
+  ASSERT_EQ(expected.doc, actual.doc);
+
+  // empty score
+  expected.score.clear();
+  ASSERT_TRUE(irs::top_docs_collector::from_cursor(
+    actual, irs::top_docs_collector::to_cursor(expected)
+  ));
+  ASSERT_TRUE(actual.score.empty());
+  ASSERT_EQ(100500, actual.doc);
+
+  // malformed tokens
+  ASSERT_FALSE(irs::top_docs_collector::from_cursor(actual, ""));
+  ASSERT_FALSE(irs::top_docs_collector::from_cursor(actual, token.substr(0, 10)));
+  ASSERT_FALSE(irs::top_docs_collector::from_cursor(actual, token.substr(1)));
+  ASSERT_FALSE(irs::top_docs_collector::from_cursor(actual, "zz" + token.substr(2)));
+  ASSERT_FALSE(irs::top_docs_collector::from_cursor(actual, "01" + token.substr(2))); // version
+
+  expected.doc = irs::type_limits<irs::type_t::doc_id_t>::invalid();
+  ASSERT_FALSE(irs::top_docs_collector::from_cursor(
+    actual, irs::top_docs_collector::to_cursor(expected)
+  ));
+
+  // score doesn't match the order
+  expected.doc = 1;
+  expected.score.resize(1);
+  ASSERT_THROW(
+    irs::top_docs_collector(irs::order::prepared::unordered(), 10, &expected),
+    irs::illegal_argument
+  );
+}
+
+TEST(top_docs_collector_test, paginate_unordered) {
+  irs::memory_directory dir;
+  auto reader = make_index(dir);
+
+  irs::by_term filter;
+  filter.field("name").term("A");
+  auto& order = irs::order::prepared::unordered();
+  auto prepared = filter.prepare(reader, order);
+
+  for (size_t page_size : { 1, 7, 100, 250, 1000 }) {
+    auto hits = collect_all_pages(reader, *prepared, order, page_size);
+    ASSERT_EQ(250, hits.size());
+
+    // ordered by segment, then by document
+    for (size_t i = 0; i < hits.size(); ++i) {
+      const size_t segment = i < 100 ? 0 : (i < 200 ? 1 : 2);
+      ASSERT_TRUE(hits[i].score.empty());
+      ASSERT_EQ(segment, hits[i].segment);
+      ASSERT_EQ(i - 100 * segment + 1, hits[i].doc);
+    }
+  }
+
+  // nothing after the last hit
+  {
+    irs::top_docs_collector::entry after;
+    after.segment = 2;
+    after.doc = 50;
+
+    irs::top_docs_collector collector(order, 10, &after);
+    size_t ordinal = 0;
+
+    for (auto& segment : reader) {
+      collector.collect(ordinal++, *prepared->execute(segment));
+    }
+
+    ASSERT_TRUE(collector.top().empty());
+  }
+
+  // empty page
+  {
+    irs::top_docs_collector collector(order, 0);
+    collector.collect(0, *prepared->execute(reader[0]));
+    ASSERT_TRUE(collector.top().empty());
+    ASSERT_TRUE(collector.cursor().empty());
+  }
+}
+
+TEST(top_docs_collector_test, paginate_ordered) {
+  irs::memory_directory dir;
+  auto reader = make_index(dir);
+
+  // score is 'doc % 7', higher first, many ties across segments
+  irs::order ord;
+  auto& sort = ord.add<tests::sort::custom_sort>(false);
+  sort.scorer_score = [](irs::doc_id_t& score)->void { score %= 7; };
+  sort.scorer_less = [](const irs::doc_id_t& lhs, const irs::doc_id_t& rhs)->bool {
+    return lhs > rhs;
+  };
+
+  irs::by_term filter;
+  filter.field("name").term("A");
+  auto order = ord.prepare();
+  auto prepared = filter.prepare(reader, order);
+
+  struct hit {
+    irs::doc_id_t score;
+    size_t segment;
+    irs::doc_id_t doc;
+
+    bool operator<(const hit& rhs) const {
+      return score > rhs.score
+        || (score == rhs.score && (segment < rhs.segment
+            || (segment == rhs.segment && doc < rhs.doc)));
+    }
+  };
+
+  std::vector<hit> expected;
+
+  for (size_t segment = 0; segment < 3; ++segment) {
+    for (irs::doc_id_t doc = 1; doc <= reader[segment].docs_count(); ++doc) {
+      expected.push_back({ irs::doc_id_t(doc % 7), segment, doc });
+    }
+  }
+
+  std::sort(expected.begin(), expected.end());
+
+  for (size_t page_size : { 1, 13, 100, 250, 1000 }) {
+    auto hits = collect_all_pages(reader, *prepared, order, page_size);
+    ASSERT_EQ(expected.size(), hits.size());
+
+    for (size_t i = 0; i < hits.size(); ++i) {
+      ASSERT_EQ(expected[i].score, order.get<irs::doc_id_t>(hits[i].score.c_str(), 0));
+      ASSERT_EQ(expected[i].segment, hits[i].segment);
+      ASSERT_EQ(expected[i].doc, hits[i].doc);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
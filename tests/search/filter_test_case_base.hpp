@@ -34,6 +34,8 @@
 #include "utils/type_limits.hpp"
 #include "index/index_tests.hpp"
 
+#include <map>
+
 NS_BEGIN(tests)
 NS_BEGIN(sort)
 
@@ -492,6 +494,113 @@ struct empty_term_reader : iresearch::singleton<empty_term_reader>, iresearch::t
   }
 }; // empty_term_reader
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class term_access_counting_reader
+/// @brief segment reader proxy counting accesses to the term dictionaries
+///        of its fields, i.e. allows to check that a filter skips a segment
+//////////////////////////////////////////////////////////////////////////////
+class term_access_counting_reader : public irs::sub_reader {
+ public:
+  explicit term_access_counting_reader(const irs::sub_reader& impl)
+    : impl_(impl) {
+  }
+
+  // number of term iterators requested by the fields
+  size_t accesses() const { return accesses_; }
+
+  virtual uint64_t live_docs_count() const override {
+    return impl_.live_docs_count();
+  }
+
+  virtual uint64_t docs_count() const override {
+    return impl_.docs_count();
+  }
+
+  virtual const irs::sub_reader& operator[](size_t i) const override {
+    assert(!i);
+    UNUSED(i);
+    return *this;
+  }
+
+  virtual size_t size() const override { return 1; }
+
+  virtual irs::doc_iterator::ptr docs_iterator() const override {
+    return impl_.docs_iterator();
+  }
+
+  virtual irs::field_iterator::ptr fields() const override {
+    return impl_.fields();
+  }
+
+  virtual irs::doc_iterator::ptr mask(irs::doc_iterator::ptr&& it) const override {
+    return impl_.mask(std::move(it));
+  }
+
+  virtual const irs::term_reader* field(const irs::string_ref& name) const override {
+    auto* field = impl_.field(name);
+
+    if (!field) {
+      return nullptr;
+    }
+
+    auto& proxy = fields_[name];
+
+    if (!proxy) {
+      proxy.reset(new term_reader(*field, accesses_));
+    }
+
+    return proxy.get();
+  }
+
+  virtual irs::column_iterator::ptr columns() const override {
+    return impl_.columns();
+  }
+
+  virtual const irs::column_meta* column(const irs::string_ref& name) const override {
+    return impl_.column(name);
+  }
+
+  virtual const irs::columnstore_reader::column_reader* column_reader(
+      irs::field_id field) const override {
+    return impl_.column_reader(field);
+  }
+
+ private:
+  class term_reader : public irs::term_reader {
+   public:
+    term_reader(const irs::term_reader& impl, size_t& accesses)
+      : impl_(impl), accesses_(accesses) {
+    }
+
+    virtual irs::seek_term_iterator::ptr iterator() const override {
+      ++accesses_;
+      return impl_.iterator();
+    }
+
+    virtual const irs::field_meta& meta() const override { return impl_.meta(); }
+
+    virtual const irs::attribute_view& attributes() const NOEXCEPT override {
+      return impl_.attributes();
+    }
+
+    virtual size_t size() const override { return impl_.size(); }
+
+    virtual uint64_t docs_count() const override { return impl_.docs_count(); }
+
+    virtual const irs::bytes_ref& (min)() const override { return (impl_.min)(); }
+
+    virtual const irs::bytes_ref& (max)() const override { return (impl_.max)(); }
+
+   private:
+    const irs::term_reader& impl_;
+    size_t& accesses_;
+  }; // term_reader
+
+  const irs::sub_reader& impl_;
+  mutable std::map<std::string, std::unique_ptr<term_reader>> fields_;
+  mutable size_t accesses_{};
+}; // term_access_counting_reader
+
 NS_END // tests
 
 #endif // IRESEARCH_FILTER_TEST_CASE_BASE
@@ -1533,6 +1533,79 @@ class granular_range_filter_test_case: public filter_test_case_base {
       );
     }
   }
+
+  void by_range_segment_bounds() {
+    // segments with disjoint value ranges
+    {
+      auto writer = open_writer();
+
+      for (int32_t base : { 0, 1000, 2000 }) {
+        for (int32_t i = 0; i < 10; ++i) {
+          granular_int_field field;
+          field.name("value");
+          field.value(base + i);
+          ASSERT_TRUE(writer->documents().insert().insert(irs::action::index, field));
+        }
+
+        writer->commit();
+      }
+    }
+
+    auto rdr = open_reader();
+    ASSERT_EQ(3, rdr.size());
+
+    // returns number of matched documents and number of segments whose term
+    // dictionary was accessed
+    auto execute = [&rdr](
+        int32_t min, bool min_incl,
+        int32_t max, bool max_incl)->std::pair<size_t, size_t> {
+      irs::numeric_token_stream min_stream;
+      min_stream.reset(min);
+      irs::numeric_token_stream max_stream;
+      max_stream.reset(max);
+
+      irs::by_granular_range query;
+      query.field("value")
+           .include<irs::Bound::MIN>(min_incl)
+           .insert<irs::Bound::MIN>(min_stream)
+           .include<irs::Bound::MAX>(max_incl)
+           .insert<irs::Bound::MAX>(max_stream);
+
+      std::pair<size_t, size_t> result(0, 0);
+
+      for (auto& segment : rdr) {
+        tests::term_access_counting_reader reader(segment);
+        auto prepared = query.prepare(reader);
+
+        for (auto docs = prepared->execute(reader); docs->next();) {
+          ++result.first;
+        }
+
+        if (reader.accesses()) {
+          ++result.second;
+        }
+      }
+
+      return result;
+    };
+
+    auto expected = [](size_t docs, size_t segments) {
+      return std::make_pair(docs, segments);
+    };
+
+    // segments above the range are skipped by their least (most granular)
+    // term, segments below the range only if their greatest (least granular)
+    // term is below the range as well
+    ASSERT_EQ(expected(3, 2), execute(1005, true, 1007, true)); // single segment
+    ASSERT_EQ(expected(2, 2), execute(9, true, 1000, true)); // bounds of adjacent segments
+    ASSERT_EQ(expected(0, 1), execute(9, false, 1000, false));
+    ASSERT_EQ(expected(0, 0), execute(-100, true, -1, true)); // before all segments
+    ASSERT_EQ(expected(1, 1), execute(-100, true, 0, true));
+    ASSERT_EQ(expected(0, 3), execute(2009, false, 5000, true)); // after all segments
+    ASSERT_EQ(expected(1, 3), execute(2009, true, 5000, true));
+    ASSERT_EQ(expected(30, 3), execute(0, true, 2009, true));
+    ASSERT_EQ(expected(10, 2), execute(10, true, 1999, true)); // between segments
+  }
 }; // granular_range_filter_test_case
 
 NS_END // tests
@@ -1631,6 +1704,10 @@ TEST_F(memory_granular_range_filter_test_case, by_range_order) {
   by_range_sequential_order();
 }
 
+TEST_F(memory_granular_range_filter_test_case, by_range_segment_bounds) {
+  by_range_segment_bounds();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
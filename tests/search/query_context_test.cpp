@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "search/boolean_filter.hpp"
+#include "search/phrase_filter.hpp"
+#include "search/prefix_filter.hpp"
+#include "search/query_context.hpp"
+#include "search/term_filter.hpp"
+#include "store/memory_directory.hpp"
+
+NS_LOCAL
+
+const size_t DOCS_COUNT = 4 * irs::query_context::CHECK_INTERVAL
+  * irs::query_context::CHECK_WINDOW;
+
+irs::directory_reader make_index(irs::directory& dir) {
+  auto writer = irs::index_writer::make(dir, irs::formats::get("1_0"), irs::OM_CREATE);
+
+  {
+    tests::templates::string_field quick("text", "quick");
+    tests::templates::string_field brown("text", "brown");
+    auto ctx = writer->documents();
+
+    for (size_t i = 0; i < DOCS_COUNT; ++i) {
+      tests::templates::string_field name("name", i % 2 ? "A" : "AB");
+      auto doc = ctx.insert();
+
+      EXPECT_TRUE(doc.insert(irs::action::index, name));
+      EXPECT_TRUE(doc.insert(irs::action::index, quick));
+      EXPECT_TRUE(doc.insert(irs::action::index, brown));
+    }
+  }
+
+  writer->commit();
+
+  return irs::directory_reader::open(dir);
+}
+
+size_t count(
+    const irs::filter& filter,
+    const irs::index_reader& reader,
+    const irs::attribute_view& ctx) {
+  auto prepared = filter.prepare(reader);
+  size_t count = 0;
+
+  for (auto& segment : reader) {
+    auto docs = prepared->execute(segment, irs::order::prepared::unordered(), ctx);
+
+    while (docs->next()) {
+      ++count;
+    }
+
+    // exhausted iterator stays at eof
+    EXPECT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(docs->value()));
+  }
+
+  return count;
+}
+
+NS_END
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST(query_context_test, check) {
+  // no budget
+  {
+    irs::query_context ctx;
+
+    for (size_t i = 0; i < 4 * irs::query_context::CHECK_INTERVAL; ++i) {
+      ASSERT_TRUE(ctx.check());
+    }
+
+    ASSERT_FALSE(ctx.incomplete());
+  }
+
+  // cancellation is detected at the next budget evaluation
+  {
+    irs::query_context ctx;
+    ASSERT_TRUE(ctx.check()); // the first check evaluates the budget
+    ctx.cancel();
+
+    size_t checks = 1;
+    while (ctx.check()) {
+      ++checks;
+    }
+
+    ASSERT_EQ(size_t(irs::query_context::CHECK_INTERVAL), checks);
+    ASSERT_TRUE(ctx.incomplete());
+    ASSERT_FALSE(ctx.check()); // stays incomplete
+  }
+
+  // expired deadline is detected at the first check
+  {
+    irs::query_context ctx(std::chrono::milliseconds(0));
+    ASSERT_FALSE(ctx.check());
+    ASSERT_TRUE(ctx.incomplete());
+  }
+
+  // deadline in the future
+  {
+    irs::query_context ctx(std::chrono::hours(1));
+
+    for (size_t i = 0; i < 4 * irs::query_context::CHECK_INTERVAL; ++i) {
+      ASSERT_TRUE(ctx.check());
+    }
+
+    ASSERT_FALSE(ctx.incomplete());
+  }
+}
+
+TEST(query_context_test, execute) {
+  irs::memory_directory dir;
+  auto reader = make_index(dir);
+  ASSERT_EQ(DOCS_COUNT, reader.docs_count());
+
+  irs::by_term term;
+  term.field("name").term("A");
+
+  irs::by_prefix prefix;
+  prefix.field("name").term("A");
+
+  irs::Or disjunction;
+  disjunction.add<irs::by_term>().field("name").term("A");
+  disjunction.add<irs::by_term>().field("name").term("AB");
+
+  irs::And conjunction;
+  conjunction.add<irs::by_term>().field("name").term("A");
+  conjunction.add<irs::by_term>().field("text").term("brown");
+
+  irs::by_phrase phrase;
+  phrase.field("text").push_back("quick").push_back("brown");
+
+  // no budget
+  {
+    irs::query_context query_ctx;
+    irs::attribute_view ctx;
+    ctx.emplace(query_ctx);
+
+    ASSERT_EQ(DOCS_COUNT / 2, count(term, reader, ctx));
+    ASSERT_EQ(DOCS_COUNT, count(prefix, reader, ctx));
+    ASSERT_EQ(DOCS_COUNT, count(disjunction, reader, ctx));
+    ASSERT_EQ(DOCS_COUNT / 2, count(conjunction, reader, ctx));
+    ASSERT_EQ(DOCS_COUNT, count(phrase, reader, ctx));
+    ASSERT_FALSE(query_ctx.incomplete());
+  }
+
+  // partial results once the budget is exhausted
+  for (const irs::filter* filter : std::vector<const irs::filter*>{
+         &term, &prefix, &disjunction, &conjunction, &phrase }) {
+    irs::query_context query_ctx(std::chrono::milliseconds(0));
+    irs::attribute_view ctx;
+    ctx.emplace(query_ctx);
+
+    const auto partial = count(*filter, reader, ctx);
+    ASSERT_TRUE(query_ctx.incomplete());
+    ASSERT_LT(partial, size_t(irs::query_context::CHECK_WINDOW));
+    ASSERT_LT(partial, count(*filter, reader, irs::attribute_view::empty_instance()));
+  }
+
+  // cancellation
+  {
+    irs::query_context query_ctx;
+    irs::attribute_view ctx;
+    ctx.emplace(query_ctx);
+
+    auto prepared = disjunction.prepare(reader);
+    auto docs = prepared->execute(reader[0], irs::order::prepared::unordered(), ctx);
+    ASSERT_TRUE(docs->next());
+    query_ctx.cancel();
+
+    size_t count = 1;
+    while (docs->next()) {
+      ++count;
+    }
+
+    ASSERT_TRUE(query_ctx.incomplete());
+    ASSERT_LT(count, DOCS_COUNT);
+  }
+}
+
+TEST(query_context_test, execute_exclusion) {
+  irs::memory_directory dir;
+  auto reader = make_index(dir);
+  auto& segment = reader[0];
+
+  // documents with name 'A' have even ids
+  irs::And query;
+  query.add<irs::by_prefix>().field("name").term("A");
+  query.add<irs::Not>().filter<irs::by_term>().field("name").term("AB");
+  auto prepared = query.prepare(reader);
+
+  // exhaust the budget at every position, truncated exclusion must not let
+  // excluded documents through
+  for (size_t cancel_at = 0; cancel_at <= DOCS_COUNT / 2; ++cancel_at) {
+    irs::query_context query_ctx;
+    irs::attribute_view ctx;
+    ctx.emplace(query_ctx);
+
+    auto docs = prepared->execute(segment, irs::order::prepared::unordered(), ctx);
+    size_t count = 0;
+
+    while (docs->next()) {
+      ASSERT_EQ(0, docs->value() % 2);
+
+      if (++count == cancel_at) {
+        query_ctx.cancel();
+      }
+    }
+
+    ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(docs->value()));
+    ASSERT_EQ(count < DOCS_COUNT / 2, query_ctx.incomplete());
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
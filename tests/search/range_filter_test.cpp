@@ -24,6 +24,7 @@
 #include "tests_shared.hpp"
 #include "filter_test_case_base.hpp"
 #include "search/range_filter.hpp"
+#include "search/term_filter.hpp"
 #include "store/memory_directory.hpp"
 #include "formats/formats_10.hpp"
 
@@ -1058,6 +1059,84 @@ TEST(by_range_test, boost) {
   }
 }
 
+TEST(by_range_test, segment_bounds) {
+  irs::memory_directory dir;
+  auto codec = irs::formats::get("1_0");
+
+  // segments with disjoint term ranges
+  {
+    auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE);
+
+    for (auto& terms : { "abc", "klm", "xyz" }) {
+      for (auto* term = terms; *term; ++term) {
+        tests::templates::string_field field("name", irs::string_ref(term, 1));
+        ASSERT_TRUE(writer->documents().insert().insert(irs::action::index, field));
+      }
+
+      writer->commit();
+    }
+  }
+
+  auto rdr = irs::directory_reader::open(dir, codec);
+  ASSERT_EQ(3, rdr.size());
+
+  // returns number of matched documents and number of segments whose term
+  // dictionary was accessed
+  auto execute = [&rdr](const irs::filter& filter)->std::pair<size_t, size_t> {
+    std::pair<size_t, size_t> result(0, 0);
+
+    for (auto& segment : rdr) {
+      tests::term_access_counting_reader reader(segment);
+      auto prepared = filter.prepare(reader);
+
+      for (auto docs = prepared->execute(reader); docs->next();) {
+        ++result.first;
+      }
+
+      if (reader.accesses()) {
+        ++result.second;
+      }
+    }
+
+    return result;
+  };
+
+  auto expected = [](size_t docs, size_t segments) {
+    return std::make_pair(docs, segments);
+  };
+
+  auto range = [](const char* min, bool min_incl, const char* max, bool max_incl) {
+    irs::by_range query;
+    query.field("name");
+
+    if (min) {
+      query.include<irs::Bound::MIN>(min_incl).term<irs::Bound::MIN>(min);
+    }
+
+    if (max) {
+      query.include<irs::Bound::MAX>(max_incl).term<irs::Bound::MAX>(max);
+    }
+
+    return query;
+  };
+
+  // term dictionaries of disjoint segments are not accessed
+  ASSERT_EQ(expected(3, 1), execute(range("k", true, "m", true))); // single segment
+  ASSERT_EQ(expected(2, 2), execute(range("c", true, "k", true))); // bounds of adjacent segments
+  ASSERT_EQ(expected(0, 0), execute(range("c", false, "k", false)));
+  ASSERT_EQ(expected(0, 0), execute(range("d", true, "j", true))); // between segments
+  ASSERT_EQ(expected(0, 0), execute(range(nullptr, false, "a", false))); // before all segments
+  ASSERT_EQ(expected(1, 1), execute(range(nullptr, false, "a", true)));
+  ASSERT_EQ(expected(0, 0), execute(range("z", false, nullptr, false))); // after all segments
+  ASSERT_EQ(expected(4, 2), execute(range("m", true, nullptr, false)));
+  ASSERT_EQ(expected(9, 3), execute(range(nullptr, false, nullptr, false)));
+
+  // by_term is checked against segment bounds as well
+  ASSERT_EQ(expected(1, 1), execute(irs::by_term().field("name").term("y")));
+  ASSERT_EQ(expected(0, 0), execute(irs::by_term().field("name").term("e")));
+  ASSERT_EQ(expected(0, 0), execute(irs::by_term().field("name").term("zz")));
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                           memory_directory + iresearch_format_10
 // ----------------------------------------------------------------------------
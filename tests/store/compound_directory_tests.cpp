@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/doc_generator.hpp"
+#include "index/index_tests.hpp"
+#include "index/index_writer.hpp"
+#include "iql/query_builder.hpp"
+#include "store/compound_directory.hpp"
+#include "store/memory_directory.hpp"
+#include "utils/index_utils.hpp"
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST(compound_directory_tests, write_read) {
+  irs::memory_directory dir;
+
+  // small file
+  {
+    auto out = dir.create("_1.a");
+    ASSERT_NE(nullptr, out);
+    out->write_int(42);
+    out->write_vlong(100500);
+  }
+
+  // file larger than a copy buffer
+  {
+    auto out = dir.create("_1.b");
+    ASSERT_NE(nullptr, out);
+
+    for (uint32_t i = 0; i < 100000; ++i) {
+      out->write_int(i);
+    }
+  }
+
+  // file which is not packed
+  {
+    auto out = dir.create("other");
+    ASSERT_NE(nullptr, out);
+    out->write_int(7);
+  }
+
+  ASSERT_FALSE(irs::compound_directory::write(dir, "_1", { "other" }));
+  ASSERT_TRUE(irs::compound_directory::write(dir, "_1", { "_1.a", "_1.b" }));
+  ASSERT_EQ("_1.cf", irs::compound_directory::file_name("_1"));
+  ASSERT_EQ(nullptr, irs::compound_directory::open(dir, "_2")); // no compound file
+
+  // compound file is renamed together with the segment
+  ASSERT_TRUE(dir.rename("_1.cf", "_2.cf"));
+  ASSERT_TRUE(dir.remove("_1.a"));
+  ASSERT_TRUE(dir.remove("_1.b"));
+
+  auto view = irs::compound_directory::open(dir, "_2");
+  ASSERT_NE(nullptr, view);
+
+  bool exists;
+  uint64_t length;
+  ASSERT_TRUE(view->exists(exists, "_2.a") && exists);
+  ASSERT_TRUE(view->exists(exists, "other") && exists); // underlying directory
+  ASSERT_TRUE(view->exists(exists, "_1.a") && !exists);
+  ASSERT_TRUE(view->length(length, "_2.b"));
+  ASSERT_EQ(400000, length);
+
+  {
+    auto in = view->open("_2.a", irs::IOAdvice::NORMAL);
+    ASSERT_NE(nullptr, in);
+    ASSERT_EQ(0, in->file_pointer());
+    ASSERT_EQ(42, in->read_int());
+    ASSERT_EQ(100500, in->read_vlong());
+    ASSERT_TRUE(in->eof());
+
+    // reads do not cross the end of the contained file
+    ASSERT_THROW(in->read_byte(), irs::eof_error);
+    ASSERT_THROW(in->read_int(), irs::eof_error);
+    ASSERT_THROW(in->read_long(), irs::eof_error);
+    ASSERT_THROW(in->read_vint(), irs::eof_error);
+    ASSERT_THROW(in->read_vlong(), irs::eof_error);
+    in->seek(1);
+    ASSERT_THROW(in->read_long(), irs::eof_error);
+    in->seek(4);
+    ASSERT_THROW(in->read_int(), irs::eof_error);
+    ASSERT_EQ(100500, in->read_vlong()); // fewer bytes left than a vlong may take
+
+    in->seek(0);
+    ASSERT_EQ(42, in->read_int());
+
+    auto dup = in->dup();
+    ASSERT_NE(nullptr, dup);
+    ASSERT_EQ(4, dup->file_pointer());
+
+    auto reopened = in->reopen();
+    ASSERT_NE(nullptr, reopened);
+    ASSERT_EQ(4, reopened->file_pointer());
+    ASSERT_EQ(100500, reopened->read_vlong());
+  }
+
+  {
+    auto in = view->open("_2.b", irs::IOAdvice::NORMAL);
+    ASSERT_NE(nullptr, in);
+    ASSERT_EQ(400000, in->length());
+
+    in->seek(4 * 99999);
+    ASSERT_EQ(99999, in->read_int());
+    ASSERT_TRUE(in->eof());
+
+    // reads do not cross the end of the contained file
+    irs::byte_type buf[16];
+    in->seek(4 * 99999);
+    ASSERT_EQ(4, in->read_bytes(buf, sizeof buf));
+
+    // checksum is calculated over the contained file only
+    in->seek(0);
+    const auto checksum = in->checksum(in->length());
+    ASSERT_EQ(checksum, in->checksum(in->length() + 100));
+    ASSERT_NE(checksum, in->checksum(in->length() - 1));
+  }
+
+  {
+    auto in = view->open("other", irs::IOAdvice::NORMAL);
+    ASSERT_NE(nullptr, in);
+    ASSERT_EQ(7, in->read_int());
+  }
+
+  std::set<std::string> files;
+  view->visit([&files](std::string& name) { files.emplace(name); return true; });
+  ASSERT_EQ((std::set<std::string>{ "_2.a", "_2.b" }), files);
+
+  // view is read-only
+  ASSERT_EQ(nullptr, view->create("_2.c"));
+  ASSERT_FALSE(view->remove("_2.a"));
+  ASSERT_FALSE(view->rename("_2.a", "_2.c"));
+}
+
+TEST(compound_directory_tests, index_writer) {
+  tests::json_doc_generator gen(
+    test_base::resource("simple_sequential.json"),
+    &tests::generic_json_field_factory
+  );
+  auto* doc1 = gen.next();
+  auto* doc2 = gen.next();
+  auto* doc3 = gen.next();
+  auto codec = irs::formats::get("1_0");
+  irs::memory_directory dir;
+
+  irs::index_writer::options options;
+  options.compound_file_max = 1 << 20;
+  auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE, options);
+
+  ASSERT_TRUE(tests::insert(*writer, doc1->indexed.begin(), doc1->indexed.end(), doc1->stored.begin(), doc1->stored.end()));
+  ASSERT_TRUE(tests::insert(*writer, doc2->indexed.begin(), doc2->indexed.end(), doc2->stored.begin(), doc2->stored.end()));
+  writer->commit();
+  ASSERT_TRUE(tests::insert(*writer, doc3->indexed.begin(), doc3->indexed.end(), doc3->stored.begin(), doc3->stored.end()));
+  writer->commit();
+
+  auto check_packed = [&dir, &codec]()->void {
+    irs::index_meta meta;
+    std::string filename;
+    auto meta_reader = codec->get_index_meta_reader();
+    ASSERT_TRUE(meta_reader->last_segments_file(dir, filename));
+    meta_reader->read(dir, meta, filename);
+
+    for (auto& segment : meta) {
+      auto mask = codec->get_document_mask_writer()->filename(segment.meta);
+      auto files = segment.meta.files;
+      files.erase(mask);
+      ASSERT_EQ(1, files.size());
+      ASSERT_EQ(irs::compound_directory::file_name(segment.meta.name), *files.begin());
+    }
+  };
+
+  check_packed();
+
+  // removal in a packed segment
+  {
+    auto query_doc1 = irs::iql::query_builder().build("name==A", std::locale::classic());
+    writer->documents().remove(std::move(query_doc1.filter));
+    writer->commit();
+    check_packed();
+
+    auto reader = irs::directory_reader::open(dir, codec);
+    ASSERT_EQ(2, reader.size());
+    ASSERT_EQ(3, reader.docs_count());
+    ASSERT_EQ(2, reader.live_docs_count());
+
+    auto& segment = reader[0];
+    auto* column = segment.column_reader("name");
+    ASSERT_NE(nullptr, column);
+    auto values = column->values();
+    irs::bytes_ref actual_value;
+    ASSERT_TRUE(values(2, actual_value));
+    ASSERT_EQ("B", irs::to_string<irs::string_ref>(actual_value.c_str()));
+
+    auto* field = segment.field("name");
+    ASSERT_NE(nullptr, field);
+    ASSERT_EQ(2, field->docs_count());
+  }
+
+  // consolidated segment is packed
+  {
+    ASSERT_TRUE(writer->consolidate(irs::index_utils::consolidation_policy(irs::index_utils::consolidate_count())));
+    writer->commit();
+    check_packed();
+
+    auto reader = irs::directory_reader::open(dir, codec);
+    ASSERT_EQ(1, reader.size());
+    ASSERT_EQ(2, reader.docs_count());
+
+    auto& segment = reader[0];
+    auto terms = segment.field("name")->iterator();
+    ASSERT_TRUE(terms->next());
+    ASSERT_EQ("B", irs::ref_cast<char>(terms->value()));
+    ASSERT_TRUE(terms->next());
+    ASSERT_EQ("C", irs::ref_cast<char>(terms->value()));
+    ASSERT_FALSE(terms->next());
+  }
+
+  // too big segments are not packed
+  {
+    irs::memory_directory dir;
+    irs::index_writer::options options;
+    options.compound_file_max = 1;
+    auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE, options);
+    ASSERT_TRUE(tests::insert(*writer, doc1->indexed.begin(), doc1->indexed.end(), doc1->stored.begin(), doc1->stored.end()));
+    writer->commit();
+
+    auto reader = irs::directory_reader::open(dir, codec);
+    ASSERT_EQ(1, reader.size());
+
+    bool exists;
+    ASSERT_TRUE(dir.exists(exists, "_1.cf") && !exists);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -108,6 +108,44 @@ TEST_F(mmap_directory_test, lock_obtain_release) {
   lock_obtain_release();
 }
 
+TEST_F(mmap_directory_test, huge_pages) {
+  irs::mmap_directory dir(path().utf8(), 1024);
+
+  // small file
+  {
+    auto out = dir.create("small");
+    ASSERT_NE(nullptr, out);
+    out->write_int(42);
+  }
+
+  // file exceeding the huge page threshold
+  {
+    auto out = dir.create("large");
+    ASSERT_NE(nullptr, out);
+
+    for (uint32_t i = 0; i < 1024; ++i) {
+      out->write_int(i);
+    }
+  }
+
+  // huge pages are only a hint, files are readable regardless
+  {
+    auto in = dir.open("small", irs::IOAdvice::RANDOM);
+    ASSERT_NE(nullptr, in);
+    ASSERT_EQ(42, in->read_int());
+  }
+
+  for (auto advice : { irs::IOAdvice::NORMAL, irs::IOAdvice::READONCE }) {
+    auto in = dir.open("large", advice);
+    ASSERT_NE(nullptr, in);
+    ASSERT_EQ(4096, in->length());
+
+    for (uint32_t i = 0; i < 1024; ++i) {
+      ASSERT_EQ(i, uint32_t(in->read_int()));
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
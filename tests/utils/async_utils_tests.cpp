@@ -23,7 +23,10 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <ctime>
 #include <mutex>
+#include <stdexcept>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "utils/async_utils.hpp"
@@ -360,6 +363,122 @@ TEST_F(async_utils_tests, test_read_write_mutex_mt) {
 
 }
 
+TEST_F(async_utils_tests, test_distributed_read_write_mutex_mt) {
+  typedef irs::async_utils::distributed_read_write_mutex mutex_t;
+  typedef mutex_t::read_mutex r_mutex_t;
+  typedef mutex_t::write_mutex w_mutex_t;
+
+  // concurrent read lock
+  {
+    mutex_t mutex;
+    r_mutex_t wrapper(mutex);
+    std::lock_guard<r_mutex_t> lock(wrapper);
+
+    ASSERT_FALSE(mutex.owns_write());
+
+    std::thread thread([&wrapper]()->void{ std::unique_lock<r_mutex_t> lock(wrapper); ASSERT_TRUE(lock.owns_lock()); });
+    thread.join();
+  }
+
+  // exclusive write lock, recursive write and read locks
+  {
+    mutex_t mutex;
+    w_mutex_t wrapper(mutex);
+    std::lock_guard<w_mutex_t> lock(wrapper);
+
+    ASSERT_TRUE(mutex.owns_write());
+    ASSERT_TRUE(wrapper.try_lock()); // recursive write lock
+    mutex.lock_read(); // recursive read lock
+    mutex.unlock();
+    wrapper.unlock();
+    ASSERT_TRUE(mutex.owns_write());
+
+    std::thread thread([&mutex]()->void{
+      ASSERT_FALSE(w_mutex_t(mutex).try_lock());
+      ASSERT_FALSE(r_mutex_t(mutex).try_lock());
+    });
+    thread.join();
+  }
+
+  // read block write
+  {
+    mutex_t mutex;
+    r_mutex_t wrapper(mutex);
+    std::lock_guard<r_mutex_t> lock(wrapper);
+
+    std::thread thread([&mutex]()->void{ w_mutex_t wrapper(mutex); ASSERT_FALSE(wrapper.try_lock()); });
+    thread.join();
+  }
+
+  // read lock released by another thread unblocks write
+  {
+    mutex_t mutex(256); // maximum number of slots, the lock is likely released via another counter
+    r_mutex_t r_wrapper(mutex);
+
+    r_wrapper.lock();
+
+    std::thread thread([&r_wrapper]()->void{ r_wrapper.unlock(); });
+    thread.join();
+
+    w_mutex_t w_wrapper(mutex);
+    ASSERT_TRUE(w_wrapper.try_lock());
+    w_wrapper.unlock();
+  }
+
+  // downgrade write lock to read lock
+  {
+    mutex_t mutex;
+    w_mutex_t wrapper(mutex);
+
+    wrapper.lock();
+    wrapper.unlock(true); // downgrade
+    ASSERT_FALSE(mutex.owns_write());
+
+    std::thread thread([&mutex]()->void{
+      ASSERT_TRUE(r_mutex_t(mutex).try_lock());
+      mutex.unlock();
+      ASSERT_FALSE(w_mutex_t(mutex).try_lock());
+    });
+    thread.join();
+    mutex.unlock(); // release read lock
+  }
+
+  // writer waits for readers, readers wait for the writer
+  {
+    mutex_t mutex;
+    size_t value = 0; // guarded by 'mutex'
+    std::atomic<bool> mismatch(false);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < 8; ++i) {
+      threads.emplace_back([&mutex, &value, &mismatch, i]()->void {
+        for (size_t j = 0; j < 10000; ++j) {
+          if (0 == (i + j) % 10) {
+            w_mutex_t wrapper(mutex);
+            std::lock_guard<w_mutex_t> lock(wrapper);
+            const auto expected = ++value;
+            std::this_thread::yield();
+            mismatch = mismatch || expected != value;
+          } else {
+            r_mutex_t wrapper(mutex);
+            std::lock_guard<r_mutex_t> lock(wrapper);
+            const auto expected = value;
+            std::this_thread::yield();
+            mismatch = mismatch || expected != value;
+          }
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    ASSERT_FALSE(mismatch);
+    ASSERT_EQ(8000, value);
+  }
+}
+
 TEST_F(async_utils_tests, test_thread_pool_run_mt) {
   // test schedule 1 task
   {
@@ -646,6 +765,218 @@ TEST_F(async_utils_tests, test_thread_pool_stop_mt) {
   }
 }
 
+TEST_F(async_utils_tests, test_task_scheduler_run_mt) {
+  typedef irs::async_utils::task_scheduler scheduler_t;
+
+  // test run many tasks
+  {
+    scheduler_t::options opts;
+    opts.threads = 4;
+    scheduler_t scheduler(opts);
+    std::atomic<size_t> count(0);
+
+    ASSERT_EQ(4, scheduler.threads());
+
+    for (size_t i = 0; i < 10000; ++i) {
+      ASSERT_TRUE(scheduler.run([&count]()->void { ++count; }));
+    }
+
+    scheduler.stop(); // finishes pending tasks
+    ASSERT_EQ(10000, count);
+    ASSERT_EQ(0, scheduler.tasks_pending());
+    ASSERT_FALSE(scheduler.run([]()->void {})); // stopped
+  }
+
+  // test exception in a task does not terminate a worker
+  {
+    scheduler_t::options opts;
+    opts.threads = 1;
+    opts.pin_threads = true;
+    scheduler_t scheduler(opts);
+    std::atomic<size_t> count(0);
+
+    scheduler.run([&count]()->void { ++count; throw "error"; });
+    scheduler.run([&count]()->void { ++count; });
+    scheduler.stop();
+    ASSERT_EQ(2, count);
+  }
+
+  // test higher priority tasks are taken first
+  {
+    scheduler_t::options opts;
+    opts.threads = 1;
+    scheduler_t scheduler(opts);
+    std::mutex mutex;
+    std::vector<scheduler_t::priority> order;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    scheduler.run([&mutex]()->void { std::lock_guard<std::mutex> lock(mutex); }); // block the worker
+
+    while (scheduler.tasks_pending()) {
+      std::this_thread::yield(); // wait for the worker to take the blocking task
+    }
+
+    auto task = [&order](scheduler_t::priority prio) {
+      return [&order, prio]()->void { order.emplace_back(prio); };
+    };
+
+    scheduler.run(task(scheduler_t::priority::MERGE), scheduler_t::priority::MERGE);
+    scheduler.run(task(scheduler_t::priority::FLUSH), scheduler_t::priority::FLUSH);
+    scheduler.run(task(scheduler_t::priority::QUERY), scheduler_t::priority::QUERY);
+    lock.unlock();
+    scheduler.stop();
+
+    ASSERT_EQ(
+      (std::vector<scheduler_t::priority>{
+        scheduler_t::priority::QUERY,
+        scheduler_t::priority::FLUSH,
+        scheduler_t::priority::MERGE
+      }),
+      order
+    );
+  }
+
+  // test stop skipping pending tasks
+  {
+    scheduler_t::options opts;
+    opts.threads = 1;
+    scheduler_t scheduler(opts);
+    std::mutex mutex;
+    std::atomic<size_t> count(0);
+    std::unique_lock<std::mutex> lock(mutex);
+
+    scheduler.run([&mutex, &count]()->void { ++count; std::lock_guard<std::mutex> lock(mutex); });
+
+    while (!count) {
+      std::this_thread::yield(); // wait for the worker to start the blocking task
+    }
+
+    scheduler.run([&count]()->void { ++count; });
+    ASSERT_EQ(1, scheduler.tasks_pending());
+
+    std::thread thread([&scheduler]()->void { scheduler.stop(true); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    lock.unlock();
+    thread.join();
+
+    ASSERT_EQ(1, count); // pending task was dropped
+    ASSERT_EQ(0, scheduler.tasks_pending());
+  }
+}
+
+TEST_F(async_utils_tests, test_task_group_mt) {
+  typedef irs::async_utils::task_scheduler scheduler_t;
+
+  // recursive fork/join does not exhaust workers
+  {
+    scheduler_t::options opts;
+    opts.threads = 2;
+    scheduler_t scheduler(opts);
+
+    std::function<size_t(size_t)> fib = [&scheduler, &fib](size_t n)->size_t {
+      if (n < 2) {
+        return n;
+      }
+
+      size_t lhs, rhs;
+      scheduler_t::task_group group(&scheduler);
+
+      group.run([&lhs, &fib, n]()->void { lhs = fib(n - 1); });
+      group.run([&rhs, &fib, n]()->void { rhs = fib(n - 2); });
+      group.wait();
+
+      return lhs + rhs;
+    };
+
+    ASSERT_EQ(6765, fib(20));
+  }
+
+  // exception of a subtask is rethrown by wait()
+  {
+    scheduler_t::options opts;
+    opts.threads = 2;
+    scheduler_t scheduler(opts);
+    std::atomic<size_t> count(0);
+    scheduler_t::task_group group(&scheduler, scheduler_t::priority::MERGE);
+
+    for (size_t i = 0; i < 100; ++i) {
+      group.run([&count, i]()->void {
+        ++count;
+
+        if (i == 42) {
+          throw std::runtime_error("error");
+        }
+      });
+    }
+
+    ASSERT_THROW(group.wait(), std::runtime_error);
+    ASSERT_EQ(100, count); // all subtasks are finished
+    group.wait(); // error is reported once
+  }
+
+  // no scheduler or stopped scheduler runs subtasks on the current thread
+  {
+    const auto id = std::this_thread::get_id();
+    std::thread::id actual;
+
+    {
+      scheduler_t::task_group group(nullptr);
+      group.run([&actual]()->void { actual = std::this_thread::get_id(); });
+      ASSERT_EQ(id, actual);
+    }
+
+    scheduler_t scheduler;
+    scheduler.stop();
+
+    {
+      actual = std::thread::id();
+      scheduler_t::task_group group(&scheduler);
+      group.run([&actual]()->void { actual = std::this_thread::get_id(); });
+      group.wait();
+      ASSERT_EQ(id, actual);
+    }
+  }
+
+  // waiting for subtasks executed by workers does not spin
+  {
+    scheduler_t::options opts;
+    opts.threads = 2;
+    scheduler_t scheduler(opts);
+    std::condition_variable cond;
+    std::mutex mutex;
+    bool released = false;
+    std::atomic<size_t> count(0);
+    scheduler_t::task_group group(&scheduler);
+
+    for (size_t i = 0; i < 2; ++i) {
+      group.run([&cond, &mutex, &released, &count]()->void {
+        ++count;
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&released]()->bool { return released; });
+      });
+    }
+
+    while (count < 2) {
+      std::this_thread::yield(); // wait for the workers to take both subtasks
+    }
+
+    std::thread thread([&cond, &mutex, &released]()->void {
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+      std::lock_guard<std::mutex> lock(mutex);
+      released = true;
+      cond.notify_all();
+    });
+
+    const auto start = std::clock(); // CPU time of the whole process
+    group.wait();
+    const auto cpu = std::clock() - start;
+    thread.join();
+
+    // all threads sleep, a spinning waiter would take most of the 200 ms
+    ASSERT_LT(cpu, CLOCKS_PER_SEC / 20);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
\ No newline at end of file
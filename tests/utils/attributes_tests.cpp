@@ -23,6 +23,7 @@
 
 #include "tests_shared.hpp"
 #include "utils/attributes.hpp"
+#include "analysis/token_attributes.hpp"
 
 NS_LOCAL
 
@@ -351,6 +352,50 @@ TEST(attributes_tests, view_visit) {
   }
 }
 
+TEST(attributes_tests, view_slots) {
+  ASSERT_EQ(irs::attribute::DOCUMENT, irs::document::type().slot());
+  ASSERT_EQ(irs::attribute::FREQUENCY, irs::frequency::type().slot());
+  ASSERT_EQ(irs::attribute::NO_SLOT, tests::attribute::type().slot());
+
+  irs::document doc;
+  irs::frequency freq;
+  tests::attribute value;
+
+  irs::attribute_view attrs;
+  ASSERT_FALSE(attrs.contains<irs::document>());
+  ASSERT_FALSE(attrs.get<irs::document>());
+  attrs.emplace(doc);
+  attrs.emplace<irs::frequency>() = &freq; // fill placeholder
+  attrs.emplace(value);
+  ASSERT_EQ(3, attrs.size());
+  ASSERT_TRUE(attrs.contains<irs::document>());
+  ASSERT_TRUE(attrs.contains(irs::frequency::type()));
+  ASSERT_EQ(&doc, attrs.get<irs::document>()->get());
+  ASSERT_EQ(&freq, attrs.get<irs::frequency>()->get());
+  ASSERT_EQ(&value, attrs.get<tests::attribute>()->get());
+  ASSERT_EQ(flags({ irs::document::type(), irs::frequency::type(), tests::attribute::type() }), attrs.features());
+
+  // slots follow the entries of the map
+  irs::attribute_view moved(std::move(attrs));
+  ASSERT_FALSE(attrs.contains<irs::document>());
+  ASSERT_FALSE(attrs.get<irs::frequency>());
+  ASSERT_EQ(&doc, moved.get<irs::document>()->get());
+  ASSERT_EQ(&freq, moved.get<irs::frequency>()->get());
+
+  // remove slotted attribute
+  ASSERT_TRUE(moved.remove<irs::document>());
+  ASSERT_FALSE(moved.remove<irs::document>());
+  ASSERT_FALSE(moved.contains<irs::document>());
+  ASSERT_FALSE(moved.get<irs::document>());
+  ASSERT_EQ(2, moved.size());
+
+  // clear
+  moved.clear();
+  ASSERT_FALSE(moved.contains<irs::frequency>());
+  ASSERT_FALSE(moved.get<irs::frequency>());
+  ASSERT_EQ(0, moved.size());
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
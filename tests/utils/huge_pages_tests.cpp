@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "store/memory_directory.hpp"
+#include "utils/block_pool.hpp"
+#include "utils/huge_pages.hpp"
+
+#include <cstring>
+
+NS_LOCAL
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restores process-wide huge page mode on scope exit
+////////////////////////////////////////////////////////////////////////////////
+struct huge_pages_guard {
+  explicit huge_pages_guard(irs::memory::huge_pages_mode mode)
+    : prev(irs::memory::huge_pages()) {
+    irs::memory::huge_pages(mode);
+  }
+
+  ~huge_pages_guard() {
+    irs::memory::huge_pages(prev);
+  }
+
+  irs::memory::huge_pages_mode prev;
+};
+
+NS_END
+
+TEST(huge_pages_tests, mode) {
+  ASSERT_EQ(irs::memory::huge_pages_mode::NONE, irs::memory::huge_pages());
+
+  {
+    huge_pages_guard guard(irs::memory::huge_pages_mode::TRANSPARENT);
+    ASSERT_EQ(irs::memory::huge_pages_mode::TRANSPARENT, irs::memory::huge_pages());
+  }
+
+  ASSERT_EQ(irs::memory::huge_pages_mode::NONE, irs::memory::huge_pages());
+
+  // region does not span a huge page
+  char buf[16];
+  ASSERT_FALSE(irs::memory::advise_huge_pages(buf, sizeof buf));
+}
+
+TEST(huge_pages_tests, arena) {
+  irs::memory::huge_page_arena arena;
+
+  auto* first = arena.allocate(100);
+  ASSERT_NE(nullptr, first);
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(first) % irs::memory::HUGE_PAGE_SIZE);
+  std::memset(first, 1, 100);
+
+  auto* second = arena.allocate(100);
+  ASSERT_NE(nullptr, second);
+  ASSERT_NE(first, second);
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(second) % 64);
+
+  // released allocations are reused by allocations of the same size only
+  arena.deallocate(first, 100);
+  auto* third = arena.allocate(200);
+  ASSERT_NE(first, third);
+  ASSERT_EQ(first, arena.allocate(100));
+  ASSERT_EQ(1, arena.chunks());
+
+  // allocation larger than a huge page
+  auto* large = static_cast<irs::byte_type*>(
+    arena.allocate(3 * irs::memory::HUGE_PAGE_SIZE)
+  );
+  ASSERT_NE(nullptr, large);
+  std::memset(large, 1, 3 * irs::memory::HUGE_PAGE_SIZE);
+  ASSERT_EQ(2, arena.chunks());
+
+  // the first chunk is released as soon as it has no live allocations
+  arena.deallocate(first, 100);
+  arena.deallocate(second, 100);
+  ASSERT_EQ(2, arena.chunks());
+  arena.deallocate(third, 200);
+  ASSERT_EQ(1, arena.chunks());
+
+  // the current chunk is kept and reused from its beginning
+  arena.deallocate(large, 3 * irs::memory::HUGE_PAGE_SIZE);
+  ASSERT_EQ(1, arena.chunks());
+  ASSERT_EQ(large, arena.allocate(100));
+  ASSERT_NE(large, arena.allocate(100)); // released blocks were dropped
+  ASSERT_EQ(1, arena.chunks());
+}
+
+TEST(huge_pages_tests, allocator) {
+  irs::memory::huge_page_allocator<uint64_t> regular;
+  ASSERT_FALSE(regular.huge());
+
+  huge_pages_guard guard(irs::memory::huge_pages_mode::EXPLICIT);
+  irs::memory::huge_page_allocator<uint64_t> huge;
+  ASSERT_TRUE(huge.huge());
+  ASSERT_NE(regular, huge);
+
+  // every allocator gets its own arena, copies share it
+  irs::memory::huge_page_allocator<uint64_t> other;
+  ASSERT_NE(huge, other);
+  irs::memory::huge_page_allocator<char> copy(huge);
+  ASSERT_EQ(huge, copy);
+  ASSERT_EQ(huge.arena(), copy.arena());
+
+  // mode is captured on construction, rebound allocators keep it
+  irs::memory::huge_page_allocator<char> rebound(regular);
+  ASSERT_FALSE(rebound.huge());
+  ASSERT_EQ(regular, rebound);
+
+  auto* p = huge.allocate(1024);
+  ASSERT_NE(nullptr, p);
+
+  for (size_t i = 0; i < 1024; ++i) {
+    p[i] = i;
+  }
+
+  huge.deallocate(p, 1024);
+
+  auto* q = regular.allocate(16);
+  ASSERT_NE(nullptr, q);
+  regular.deallocate(q, 16);
+}
+
+TEST(huge_pages_tests, block_pool) {
+  typedef irs::block_pool<irs::byte_type, 32768> pool_t;
+
+  huge_pages_guard guard(irs::memory::huge_pages_mode::TRANSPARENT);
+  pool_t pool; // blocks are allocated from an arena of the pool
+
+  pool_t::inserter out(pool.begin());
+
+  for (uint32_t i = 0; i < 100000; ++i) {
+    out.write(reinterpret_cast<const irs::byte_type*>(&i), sizeof i);
+  }
+
+  ASSERT_LE(100000 * sizeof(uint32_t), pool.size());
+
+  auto where = pool.begin();
+
+  for (uint32_t i = 0; i < 100000; ++i) {
+    uint32_t value;
+    where = pool.read(where, reinterpret_cast<irs::byte_type*>(&value), sizeof value);
+    ASSERT_EQ(i, value);
+  }
+
+  // pool created after the mode change uses regular pages, while blocks of
+  // the existing pool are still released to the arena
+  irs::memory::huge_pages(irs::memory::huge_pages_mode::NONE);
+  pool_t regular_pool;
+  regular_pool.alloc_buffer(2);
+  ASSERT_EQ(2, regular_pool.block_count());
+  pool.alloc_buffer(1);
+  pool.clear();
+  ASSERT_EQ(0, pool.block_count());
+}
+
+TEST(huge_pages_tests, block_pool_release) {
+  typedef irs::memory::huge_page_allocator<irs::byte_type> block_allocator;
+  typedef irs::block_pool<
+    irs::byte_type, 32768, std::allocator<irs::byte_type>, block_allocator
+  > pool_t;
+
+  huge_pages_guard guard(irs::memory::huge_pages_mode::TRANSPARENT);
+  block_allocator alloc;
+  pool_t pool(std::allocator<irs::byte_type>(), alloc);
+  auto& arena = *alloc.arena();
+
+  // enough blocks to span several chunks
+  const size_t count = 4 * irs::memory::HUGE_PAGE_SIZE / 32768;
+
+  pool.alloc_buffer(count);
+  ASSERT_EQ(count, pool.block_count());
+  ASSERT_LT(size_t(3), arena.chunks());
+
+  // all chunks but the current one are returned to the system
+  pool.clear();
+  ASSERT_EQ(1, arena.chunks());
+
+  pool.alloc_buffer(count);
+  ASSERT_LT(size_t(3), arena.chunks());
+}
+
+TEST(huge_pages_tests, memory_directory) {
+  huge_pages_guard guard(irs::memory::huge_pages_mode::TRANSPARENT);
+  irs::memory_directory dir;
+
+  // large enough to get buffers spanning huge pages
+  const uint32_t count = 2 * irs::memory::HUGE_PAGE_SIZE;
+
+  {
+    auto out = dir.create("file");
+    ASSERT_NE(nullptr, out);
+
+    for (uint32_t i = 0; i < count; ++i) {
+      out->write_int(i);
+    }
+  }
+
+  auto in = dir.open("file", irs::IOAdvice::NORMAL);
+  ASSERT_NE(nullptr, in);
+
+  for (uint32_t i = 0; i < count; ++i) {
+    ASSERT_EQ(i, uint32_t(in->read_int()));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
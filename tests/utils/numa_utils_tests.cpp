@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2019 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "store/directory_attributes.hpp"
+#include "utils/async_utils.hpp"
+#include "utils/numa_utils.hpp"
+
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+TEST(numa_utils_tests, topology) {
+  const auto nodes = irs::numa_utils::nodes();
+
+  ASSERT_LE(1, nodes);
+  ASSERT_GT(nodes, irs::numa_utils::current_node());
+  ASSERT_FALSE(irs::numa_utils::bind_current_thread(nodes)); // no such node
+}
+
+#ifdef __linux__
+
+TEST(numa_utils_tests, topology_sparse_nodes) {
+  std::ifstream in("/sys/devices/system/node/has_cpu");
+
+  if (!in) {
+    return; // no NUMA information available
+  }
+
+  std::string list;
+  std::getline(in, list);
+
+  // every node with CPUs is counted, even if node ids are sparse, e.g. '0,2-3'
+  size_t expected = 0;
+  std::stringstream ranges(list);
+
+  for (std::string range; std::getline(ranges, range, ',');) {
+    const auto dash = range.find('-');
+
+    expected += std::string::npos == dash
+      ? 1
+      : std::stoul(range.substr(dash + 1)) - std::stoul(range.substr(0, dash)) + 1;
+  }
+
+  ASSERT_EQ((std::max)(expected, size_t(1)), irs::numa_utils::nodes());
+}
+
+#endif // __linux__
+
+TEST(numa_utils_tests, bind_current_thread) {
+  const auto nodes = irs::numa_utils::nodes();
+  irs::memory_allocator alloc(1);
+
+  // every node has an allocator of its own
+  for (size_t node = 1; node < nodes; ++node) {
+    ASSERT_NE(&alloc.node(node - 1), &alloc.node(node));
+  }
+
+  for (size_t node = 0; node < nodes; ++node) {
+    std::thread thread([node, &alloc]()->void {
+      ASSERT_TRUE(irs::numa_utils::bind_current_thread(node));
+      ASSERT_EQ(node, irs::numa_utils::current_node());
+
+      // allocator of the current node is used
+      irs::memory_allocator::allocator_type& actual = alloc;
+      ASSERT_EQ(&alloc.node(node), &actual);
+    });
+
+    thread.join();
+  }
+}
+
+TEST(numa_utils_tests, task_scheduler_bind_nodes) {
+  const auto nodes = irs::numa_utils::nodes();
+
+  irs::async_utils::task_scheduler::options opts;
+  opts.threads = 2 * nodes;
+  opts.bind_numa_nodes = true;
+
+  irs::async_utils::task_scheduler scheduler(opts);
+  std::condition_variable cond;
+  std::mutex mutex;
+  std::map<std::thread::id, size_t> workers; // worker -> NUMA node
+
+  // every task blocks until all of them are started, i.e. each worker
+  // executes exactly one task
+  for (size_t i = 0; i < opts.threads; ++i) {
+    ASSERT_TRUE(scheduler.run([&cond, &mutex, &workers, &opts]()->void {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      workers.emplace(std::this_thread::get_id(), irs::numa_utils::current_node());
+      cond.notify_all();
+      cond.wait(lock, [&workers, &opts]()->bool {
+        return workers.size() == opts.threads;
+      });
+    }));
+  }
+
+  scheduler.stop();
+  ASSERT_EQ(opts.threads, workers.size());
+
+  // worker 'i' is bound to node 'i % nodes', i.e. 2 workers per node
+  std::vector<size_t> workers_per_node(nodes);
+
+  for (auto& entry : workers) {
+    ASSERT_GT(nodes, entry.second);
+    ++workers_per_node[entry.second];
+  }
+
+  for (auto count : workers_per_node) {
+    ASSERT_EQ(2, count);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
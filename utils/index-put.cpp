@@ -62,6 +62,7 @@
 #include "analysis/text_token_stream.hpp"
 #include "store/store_utils.hpp"
 #include "utils/index_utils.hpp"
+#include "utils/utf8_path.hpp"
 
 #include <boost/chrono.hpp>
 #include <fstream>
@@ -75,6 +76,9 @@ NS_LOCAL
 
 const std::string HELP = "help";
 const std::string BATCH_SIZE = "batch-size";
+const std::string BULK = "bulk";
+const std::string BULK_MEMORY = "bulk-memory";
+const std::string BULK_SEGMENTS = "bulk-segments";
 const std::string CONSOLIDATE = "consolidate";
 const std::string INDEX_DIR = "index-dir";
 const std::string OUTPUT = "out";
@@ -104,6 +108,52 @@ const irs::flags numeric_features{
   irs::granularity_prefix::type()
 };
 
+const std::string RUNS_SUFFIX = ".runs"; // directory of bulk build runs
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief merge all runs from 'runs_dir' into 'segments_count' segments of
+///        'dir' with a k-way merge of each group of runs on 'threads' threads
+////////////////////////////////////////////////////////////////////////////////
+int merge_runs(
+    irs::directory& dir,
+    irs::directory& runs_dir,
+    const irs::format::ptr& codec,
+    size_t segments_count,
+    size_t threads
+) {
+  irs::index_meta runs_meta;
+  std::string filename;
+  auto meta_reader = codec->get_index_meta_reader();
+
+  if (!meta_reader->last_segments_file(runs_dir, filename)) {
+    std::cerr << "Unable to find runs of the bulk build" << std::endl;
+    return 1;
+  }
+
+  meta_reader->read(runs_dir, runs_meta, filename);
+
+  irs::index_writer::options options;
+  options.flush_pool_size = threads;
+
+  irs::index_writer::import_options import_options;
+  import_options.segments_per_group =
+    (runs_meta.size() + segments_count - 1) / segments_count;
+
+  std::cout << "Merging " << runs_meta.size() << " runs into "
+            << segments_count << " segments" << std::endl;
+
+  auto writer = irs::index_writer::make(dir, codec, irs::OM_CREATE, options);
+
+  if (!writer->import(runs_dir, runs_meta, import_options)) {
+    std::cerr << "Unable to merge runs of the bulk build" << std::endl;
+    return 1;
+  }
+
+  writer->commit();
+
+  return 0;
+}
+
 NS_END
 
 struct Doc {
@@ -359,7 +409,10 @@ int put(
     size_t indexer_threads,
     size_t commit_interval_ms,
     size_t batch_size,
-    bool consolidate
+    bool consolidate,
+    bool bulk,
+    size_t bulk_memory,
+    size_t bulk_segments
 ) {
   auto dir = create_directory(dir_type, path);
 
@@ -375,10 +428,33 @@ int put(
     return 1;
   }
 
-  auto writer = irs::index_writer::make(*dir, codec, irs::OM_CREATE);
-
   indexer_threads = (std::max)(size_t(1), (std::min)(indexer_threads, (std::numeric_limits<size_t>::max)() - 1 - 1)); // -1 for commiter thread -1 for stream reader thread
 
+  // in bulk mode documents are written to sorted runs of bounded size which
+  // are merged into the final segments once, without intermediate commits
+  const auto runs_path = path + RUNS_SUFFIX;
+  irs::directory::ptr runs_dir;
+  irs::index_writer::options options;
+
+  if (bulk) {
+    runs_dir = create_directory(dir_type, runs_path);
+
+    if (!runs_dir) {
+      std::cerr << "Unable to create directory of type '" << dir_type << "'" << std::endl;
+      return 1;
+    }
+
+    // every indexer thread fills its own run
+    options.segment_count_max = indexer_threads;
+    options.segment_memory_max = (std::max)(size_t(1), bulk_memory / indexer_threads);
+    commit_interval_ms = 0;
+    consolidate = false;
+  }
+
+  auto writer = irs::index_writer::make(
+    bulk ? *runs_dir : *dir, codec, irs::OM_CREATE, options
+  );
+
   irs::async_utils::thread_pool thread_pool(indexer_threads + 1 + 1); // +1 for commiter thread +1 for stream reader thread
 
   SCOPED_TIMER("Total Time");
@@ -391,6 +467,12 @@ int put(
   std::cout << CPR << "=" << commit_interval_ms << std::endl;
   std::cout << BATCH_SIZE << "=" << batch_size << std::endl;
   std::cout << CONSOLIDATE << "=" << consolidate << std::endl;
+  std::cout << BULK << "=" << bulk << std::endl;
+
+  if (bulk) {
+    std::cout << BULK_MEMORY << "=" << bulk_memory << std::endl;
+    std::cout << BULK_SEGMENTS << "=" << bulk_segments << std::endl;
+  }
 
   struct {
     std::condition_variable cond_;
@@ -517,6 +599,35 @@ int put(
     irs::directory_utils::remove_all_unreferenced(*dir);
   }
 
+  if (bulk) {
+    writer.reset(); // release runs
+
+    {
+      SCOPED_TIMER("Merge time");
+      auto res = merge_runs(
+        *dir, *runs_dir, codec, (std::max)(size_t(1), bulk_segments), indexer_threads
+      );
+
+      if (res) {
+        return res;
+      }
+    }
+
+    // remove runs
+    std::vector<std::string> files;
+    runs_dir->visit([&files](std::string& file) {
+      files.emplace_back(std::move(file));
+      return true;
+    });
+
+    for (auto& file : files) {
+      runs_dir->remove(file);
+    }
+
+    runs_dir.reset();
+    irs::utf8_path(runs_path).remove();
+  }
+
   u_cleanup();
 
   return 0;
@@ -535,6 +646,9 @@ int put(const cmdline::parser& args) {
 
   auto batch_size = args.exist(BATCH_SIZE) ? args.get<size_t>(BATCH_SIZE) : size_t(0);
   auto consolidate = args.exist(CONSOLIDATE) ? args.get<bool>(CONSOLIDATE) : false;
+  auto bulk = args.exist(BULK) ? args.get<bool>(BULK) : false;
+  auto bulk_memory = (args.exist(BULK_MEMORY) ? args.get<size_t>(BULK_MEMORY) : size_t(1024)) << 20;
+  auto bulk_segments = args.exist(BULK_SEGMENTS) ? args.get<size_t>(BULK_SEGMENTS) : size_t(1);
   auto commit_interval_ms = args.exist(CPR) ? args.get<size_t>(CPR) : size_t(0);
   auto indexer_threads = args.exist(THR) ? args.get<size_t>(THR) : size_t(0);
   auto lines_max = args.exist(MAX) ? args.get<size_t>(MAX) : size_t(0);
@@ -549,10 +663,10 @@ int put(const cmdline::parser& args) {
       return 1;
     }
 
-    return put(path, dir_type, format, in, lines_max, indexer_threads, commit_interval_ms, batch_size, consolidate);
+    return put(path, dir_type, format, in, lines_max, indexer_threads, commit_interval_ms, batch_size, consolidate, bulk, bulk_memory, bulk_segments);
   }
 
-  return put(path, dir_type, format, std::cin, lines_max, indexer_threads, commit_interval_ms, batch_size, consolidate);
+  return put(path, dir_type, format, std::cin, lines_max, indexer_threads, commit_interval_ms, batch_size, consolidate, bulk, bulk_memory, bulk_segments);
 }
 
 int put(int argc, char* argv[]) {
@@ -561,10 +675,13 @@ int put(int argc, char* argv[]) {
   cmdput.add(HELP, '?', "Produce help message");
   cmdput.add(INDEX_DIR, 0, "Path to index directory", true, std::string());
   cmdput.add(DIR_TYPE, 0, "Directory type (fs|mmap)", false, std::string("fs"));
-  cmdput.add(FORMAT, 0, "Format (1_0|1_0-optimized)", false, std::string("1_0"));
+  cmdput.add(FORMAT, 0, "Format (1_0|1_0-optimized|1_0-ef)", false, std::string("1_0"));
   cmdput.add(INPUT, 0, "Input file", true, std::string());
   cmdput.add(BATCH_SIZE, 0, "Lines per batch", false, size_t(0));
   cmdput.add(CONSOLIDATE, 0, "Consolidate segments", false, false);
+  cmdput.add(BULK, 0, "Build offline via sorted runs merged into final segments", false, false);
+  cmdput.add(BULK_MEMORY, 0, "Memory for sorted runs of all insert threads in MiB (bulk)", false, size_t(1024));
+  cmdput.add(BULK_SEGMENTS, 0, "Number of final segments (bulk)", false, size_t(1));
   cmdput.add(MAX, 0, "Maximum lines", false, size_t(0));
   cmdput.add(THR, 0, "Number of insert threads", false, size_t(0));
   cmdput.add(CPR, 0, "Commit period in lines", false, size_t(0));
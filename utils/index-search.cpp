@@ -63,7 +63,9 @@
 #include "search/prefix_filter.hpp"
 #include "search/boolean_filter.hpp"
 #include "search/phrase_filter.hpp"
+#include "search/query_context.hpp"
 #include "search/bm25.hpp"
+#include "search/collectors.hpp"
 #include "search/score.hpp"
 #include "utils/async_utils.hpp"
 #include "utils/memory_pool.hpp"
@@ -101,6 +103,8 @@ const std::string RND = "random";
 const std::string RPT = "repeat";
 const std::string CSV = "csv";
 const std::string SCORED_TERMS_LIMIT = "scored-terms-limit";
+const std::string BUDGET = "budget";
+const std::string TOTAL_HITS_THRESHOLD = "total-hits-threshold";
 const std::string SCORER = "scorer";
 const std::string SCORER_ARG = "scorer-arg";
 const std::string SCORER_ARG_FMT = "scorer-arg-format";
@@ -838,7 +842,9 @@ int search(
     size_t scored_terms_limit,
     const std::string& scorer,
     const std::string& scorer_arg_format,
-    const irs::string_ref& scorer_arg
+    const irs::string_ref& scorer_arg,
+    size_t budget,
+    size_t total_hits_threshold
 ) {
   static const std::map<std::string, const irs::text_format::type_id&> text_formats = {
     { "csv", irs::text_format::csv },
@@ -895,6 +901,8 @@ int search(
   std::cout << SCORER << "=" << scorer << std::endl;
   std::cout << SCORER_ARG_FMT << "=" << scorer_arg_format << std::endl;
   std::cout << SCORER_ARG << "=" << scorer_arg << std::endl;
+  std::cout << BUDGET << "=" << budget << std::endl;
+  std::cout << TOTAL_HITS_THRESHOLD << "=" << total_hits_threshold << std::endl;
 
   irs::directory_reader reader;
   irs::order::prepared order;
@@ -985,7 +993,7 @@ int search(
 
   // indexer threads
   for (size_t i = search_threads; i; --i) {
-    thread_pool.run([&task_provider, &dir, &reader, &order, limit, &out, csv, scored_terms_limit]()->void {
+    thread_pool.run([&task_provider, &dir, &reader, &order, limit, &out, csv, scored_terms_limit, budget, total_hits_threshold]()->void {
       static const std::string analyzer_name("text");
       static const std::string analyzer_args("{\"locale\":\"en\", \"ignored_words\":[\"abc\", \"def\", \"ghi\"]}"); // from index-put
       auto analyzer = irs::analysis::analyzers::get(analyzer_name, irs::text_format::json, analyzer_args);
@@ -1018,8 +1026,21 @@ int search(
       // process a single task
       for (const task_t* task; (task = ++task_provider) != nullptr;) {
         SCOPED_TIMER("Full task processing time");
-        size_t doc_count = 0;
+        irs::total_hits_collector hits(
+          total_hits_threshold
+            ? total_hits_threshold
+            : irs::integer_traits<uint64_t>::const_max // 0 == count exactly
+        );
         auto start = std::chrono::system_clock::now();
+        irs::query_context query_ctx; // 0 == unlimited budget
+        irs::attribute_view ctx;
+
+        if (budget) {
+          query_ctx.deadline(
+            irs::query_context::clock_t::now() + std::chrono::milliseconds(budget)
+          );
+          ctx.emplace(query_ctx);
+        }
 
         sorted.clear();
 
@@ -1058,7 +1079,17 @@ int search(
           const float EMPTY_SCORE = 0.f;
 
           for (auto& segment: reader) {
-            auto docs = filter->execute(segment, order); // query segment
+            if (query_ctx.incomplete()) {
+              break; // budget exhausted, keep partial top-k
+            }
+
+            auto docs = filter->execute(segment, order, ctx); // query segment
+
+            if (!limit) {
+              hits.collect(*docs); // count only, no top-k to collect
+              continue;
+            }
+
             const irs::score& score = irs::score::extract(docs->attributes());
 
 #ifdef IRESEARCH_COMPLEX_SCORING
@@ -1070,7 +1101,7 @@ int search(
               : EMPTY_SCORE;
             
             while (docs->next()) {
-              ++doc_count;
+              hits.collect();
               score.evaluate();
 
 #ifdef IRESEARCH_COMPLEX_SCORING
@@ -1087,9 +1118,13 @@ int search(
                 sorted.erase(--(sorted.end()));
               }
             }
+
+            hits.finish(*docs);
           }
         }
 
+        const auto total = hits.hits();
+
         // output task results
         {
           static std::mutex mutex;
@@ -1098,9 +1133,12 @@ int search(
           auto tdiff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
 
           if (csv) {
-            out << stringCategory(task->category) << "," << task->text << "," << doc_count << "," << tdiff.count() / 1000. << "," << tdiff.count() << std::endl;
+            out << stringCategory(task->category) << "," << task->text << "," << total.value << "," << tdiff.count() / 1000. << "," << tdiff.count() << "," << query_ctx.incomplete() << "," << total.estimate << std::endl;
           } else {
-            out << "TASK: cat=" << stringCategory(task->category) << " q='body:" << task->text << "' hits=" << doc_count << std::endl;
+            out << "TASK: cat=" << stringCategory(task->category) << " q='body:" << task->text << "' hits=" << total.value << (total.exact ? "" : "+") << (query_ctx.incomplete() ? " incomplete" : "") << std::endl;
+            if (!total.exact) {
+              out << "  about " << total.estimate << " hits" << std::endl;
+            }
             out << "  " << tdiff.count() / 1000. << " msec" << std::endl;
             out << "  thread " << std::this_thread::get_id() << std::endl;
 
@@ -1144,6 +1182,8 @@ int search(const cmdline::parser& args) {
   const size_t topN = args.get<size_t>(TOPN);
   const bool csv = args.exist(CSV);
   const size_t scored_terms_limit = args.get<size_t>(SCORED_TERMS_LIMIT);
+  const size_t budget = args.get<size_t>(BUDGET);
+  const size_t total_hits_threshold = args.get<size_t>(TOTAL_HITS_THRESHOLD);
   const auto scorer = args.get<std::string>(SCORER);
   const auto scorer_arg = args.exist(SCORER_ARG) ? irs::string_ref(args.get<std::string>(SCORER_ARG)) : irs::string_ref::NIL;
   const auto scorer_arg_format = args.get<std::string>(SCORER_ARG_FMT);
@@ -1177,10 +1217,10 @@ int search(const cmdline::parser& args) {
       return 1;
     }
 
-    return search(path, dir_type, format, in, out, maxtasks, repeat, thrs, topN, shuffle, csv, scored_terms_limit, scorer, scorer_arg_format, scorer_arg);
+    return search(path, dir_type, format, in, out, maxtasks, repeat, thrs, topN, shuffle, csv, scored_terms_limit, scorer, scorer_arg_format, scorer_arg, budget, total_hits_threshold);
   }
 
-  return search(path, dir_type, format, in, std::cout, maxtasks, repeat, thrs, topN, shuffle, csv, scored_terms_limit, scorer, scorer_arg_format, scorer_arg);
+  return search(path, dir_type, format, in, std::cout, maxtasks, repeat, thrs, topN, shuffle, csv, scored_terms_limit, scorer, scorer_arg_format, scorer_arg, budget, total_hits_threshold);
 }
 
 int search(int argc, char* argv[]) {
@@ -1189,7 +1229,7 @@ int search(int argc, char* argv[]) {
   cmdsearch.add(HELP, '?', "Produce help message");
   cmdsearch.add<std::string>(INDEX_DIR, 0, "Path to index directory", true);
   cmdsearch.add<std::string>(DIR_TYPE, 0, "Directory type (fs|mmap)", false, std::string("fs"));
-  cmdsearch.add(FORMAT, 0, "Format (1_0|1_0-optimized)", false, std::string("1_0"));
+  cmdsearch.add(FORMAT, 0, "Format (1_0|1_0-optimized|1_0-ef)", false, std::string("1_0"));
   cmdsearch.add<std::string>(INPUT, 0, "Task file", true);
   cmdsearch.add<std::string>(OUTPUT, 0, "Stats file", false);
   cmdsearch.add<size_t>(MAX, 0, "Maximum tasks per category", false, size_t(1));
@@ -1197,6 +1237,8 @@ int search(int argc, char* argv[]) {
   cmdsearch.add<size_t>(THR, 0, "Number of search threads", false, size_t(1));
   cmdsearch.add<size_t>(TOPN, 0, "Number of top search results", false, size_t(10));
   cmdsearch.add<size_t>(SCORED_TERMS_LIMIT, 0, "Number of terms to score in range/prefix queries", false, size_t(1024));
+  cmdsearch.add<size_t>(TOTAL_HITS_THRESHOLD, 0, "Count hits exactly up to this number and estimate the rest, 0 == count exactly", false, size_t(0));
+  cmdsearch.add<size_t>(BUDGET, 0, "Query execution time budget in milliseconds, 0 == unlimited", false, size_t(0));
   cmdsearch.add<std::string>(SCORER, 0, "Scorer used for ranking query results", false, "bm25");
   cmdsearch.add<std::string>(SCORER_ARG, 0, "Configuration argument for query scorer", false);
   cmdsearch.add<std::string>(SCORER_ARG_FMT, 0, "Configuration argument format for query scorer", false, "json"); // 'json' is the argument format for 'bm25'